@@ -0,0 +1,418 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_recorder.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Bus transaction recorder and replayer for PCA9534 Driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_recorder.h"
+#include <string.h>
+
+
+/* Private Variables ------------------------------------------------------------*/
+// Platform layer wrapped by the recorder
+static PCA9534_Platform_t Recorder_Inner;
+
+static PCA9534_Record_t *Recorder_Buffer = NULL;
+static uint32_t Recorder_Size = 0;
+static uint32_t Recorder_Head = 0;
+static uint32_t Recorder_Used = 0;
+static PCA9534_Recorder_Sink_t Recorder_Sink = NULL;
+// Number of handlers attached to the recorder
+static uint32_t Recorder_Attached = 0;
+
+static const PCA9534_Record_t *Replayer_Records = NULL;
+static uint32_t Replayer_Count = 0;
+static uint32_t Replayer_Index = 0;
+static uint32_t Replayer_Mismatches = 0;
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static void
+Recorder_Push(uint32_t Time, uint8_t Address, PCA9534_RecordDir_t Dir,
+              uint8_t *Data, uint8_t Len, int8_t Result)
+{
+  PCA9534_Record_t Record = {0};
+  uint8_t CopyLen = (Len < PCA9534_RECORD_DATA_MAX) ?
+                    Len : PCA9534_RECORD_DATA_MAX;
+
+  Record.Time = Time;
+  Record.Address = Address;
+  Record.Dir = (uint8_t)Dir;
+  Record.Len = Len;
+  Record.Result = Result;
+  memcpy(Record.Data, Data, CopyLen);
+
+  if (Recorder_Buffer && Recorder_Size)
+  {
+    Recorder_Buffer[Recorder_Head] = Record;
+    Recorder_Head = (Recorder_Head + 1) % Recorder_Size;
+    if (Recorder_Used < Recorder_Size)
+      Recorder_Used++;
+  }
+
+  if (Recorder_Sink)
+    Recorder_Sink(&Record);
+}
+
+
+static uint32_t
+Recorder_Time(void)
+{
+  if (!Recorder_Inner.GetTime)
+    return 0;
+
+  return Recorder_Inner.GetTime();
+}
+
+
+static int8_t
+Recorder_Send(uint8_t Address, uint8_t *Data, uint8_t Len)
+{
+  uint32_t Time = Recorder_Time();
+  int8_t Result = Recorder_Inner.Send(Address, Data, Len);
+
+  Recorder_Push(Time, Address, PCA9534_RECORD_DIR_SEND, Data, Len, Result);
+  return Result;
+}
+
+
+static int8_t
+Recorder_Receive(uint8_t Address, uint8_t *Data, uint8_t Len)
+{
+  uint32_t Time = Recorder_Time();
+  int8_t Result = Recorder_Inner.Receive(Address, Data, Len);
+
+  Recorder_Push(Time, Address, PCA9534_RECORD_DIR_RECEIVE, Data, Len, Result);
+  return Result;
+}
+
+
+static const PCA9534_Record_t *
+Replayer_Next(uint8_t Address, PCA9534_RecordDir_t Dir, uint8_t Len)
+{
+  const PCA9534_Record_t *Record = NULL;
+
+  if (Replayer_Index >= Replayer_Count)
+  {
+    Replayer_Mismatches++;
+    return NULL;
+  }
+
+  Record = &Replayer_Records[Replayer_Index++];
+  if (Record->Address != Address || Record->Dir != (uint8_t)Dir ||
+      Record->Len != Len)
+    Replayer_Mismatches++;
+
+  return Record;
+}
+
+
+static int8_t
+Replayer_Send(uint8_t Address, uint8_t *Data, uint8_t Len)
+{
+  const PCA9534_Record_t *Record = NULL;
+  uint8_t CmpLen = (Len < PCA9534_RECORD_DATA_MAX) ?
+                   Len : PCA9534_RECORD_DATA_MAX;
+
+  if (!Replayer_Records)
+    return 0;
+
+  Record = Replayer_Next(Address, PCA9534_RECORD_DIR_SEND, Len);
+  if (!Record)
+    return -1;
+
+  if (memcmp(Record->Data, Data, CmpLen) != 0)
+    Replayer_Mismatches++;
+
+  return Record->Result;
+}
+
+
+static int8_t
+Replayer_Receive(uint8_t Address, uint8_t *Data, uint8_t Len)
+{
+  const PCA9534_Record_t *Record = NULL;
+  uint8_t CopyLen = (Len < PCA9534_RECORD_DATA_MAX) ?
+                    Len : PCA9534_RECORD_DATA_MAX;
+
+  memset(Data, 0, Len);
+  if (!Replayer_Records)
+    return 0;
+
+  Record = Replayer_Next(Address, PCA9534_RECORD_DIR_RECEIVE, Len);
+  if (!Record)
+    return -1;
+
+  memcpy(Data, Record->Data, CopyLen);
+  return Record->Result;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Insert the recorder between the handler and its platform layer.
+ * @note   The platform dependent layer of the handler must be linked before
+ *         calling this function. All handlers attached at the same time must
+ *         use the same platform layer (one bus).
+ * @note   The ring is shared by all attached handlers. It is reset only by the
+ *         first attach; Buffer, Size and Sink of later attaches are ignored
+ *         until every handler has been detached.
+ * @note   When the ring is full the oldest record is overwritten.
+ * @note   With PCA9534_CONFIG_PLATFORM_STATIC the driver does not call the
+ *         pointers of the handler, so nothing could be recorded and the
+ *         recorder is not attached.
+ * @param  Handler: Pointer to handler
+ * @param  Buffer: Pointer to ring buffer (can be NULL if Sink is used)
+ * @param  Size: Number of records in ring buffer
+ * @param  Sink: Function called for every new record (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid, the
+ *                                  platform Send or Receive differs from the
+ *                                  one of the handlers already attached, or
+ *                                  the platform functions are bound
+ *                                  statically.
+ */
+PCA9534_Result_t
+PCA9534_Recorder_Attach(PCA9534_Handler_t *Handler,
+                        PCA9534_Record_t *Buffer, uint32_t Size,
+                        PCA9534_Recorder_Sink_t Sink)
+{
+#if PCA9534_CONFIG_PLATFORM_STATIC
+  // The driver does not call the pointers, so nothing would be recorded
+  return PCA9534_INVALID_PARAM;
+#endif
+
+  if (!Handler)
+    return PCA9534_INVALID_PARAM;
+
+  if (!Handler->Platform.Send || !Handler->Platform.Receive)
+    return PCA9534_INVALID_PARAM;
+
+  if ((!Buffer || !Size) && !Sink)
+    return PCA9534_INVALID_PARAM;
+
+  // Already attached
+  if (Handler->Platform.Send == Recorder_Send)
+    return PCA9534_OK;
+
+  // The recorder forwards to one platform layer only
+  if (Recorder_Attached &&
+      (Handler->Platform.Send != Recorder_Inner.Send ||
+       Handler->Platform.Receive != Recorder_Inner.Receive))
+    return PCA9534_INVALID_PARAM;
+
+  if (!Recorder_Attached)
+  {
+    Recorder_Inner = Handler->Platform;
+    Recorder_Buffer = Buffer;
+    Recorder_Size = Buffer ? Size : 0;
+    Recorder_Head = 0;
+    Recorder_Used = 0;
+    Recorder_Sink = Sink;
+  }
+  Recorder_Attached++;
+
+  PCA9534_PLATFORM_LINK_SEND(Handler, Recorder_Send);
+  PCA9534_PLATFORM_LINK_RECEIVE(Handler, Recorder_Receive);
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Remove the recorder and restore the original platform layer.
+ * @param  Handler: Pointer to handler
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Recorder_Detach(PCA9534_Handler_t *Handler)
+{
+  if (!Handler)
+    return PCA9534_INVALID_PARAM;
+
+  if (Handler->Platform.Send != Recorder_Send)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_PLATFORM_LINK_SEND(Handler, Recorder_Inner.Send);
+  PCA9534_PLATFORM_LINK_RECEIVE(Handler, Recorder_Inner.Receive);
+  Recorder_Attached--;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Number of records in the ring buffer
+ * @retval Number of records
+ */
+uint32_t
+PCA9534_Recorder_Count(void)
+{
+  return Recorder_Used;
+}
+
+
+/**
+ * @brief  Get one record from the ring buffer
+ * @param  Index: Index of record (0 is the oldest one)
+ * @param  Record: Pointer to record
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Recorder_Get(uint32_t Index, PCA9534_Record_t *Record)
+{
+  uint32_t Oldest = 0;
+
+  if (!Record || Index >= Recorder_Used)
+    return PCA9534_INVALID_PARAM;
+
+  Oldest = (Recorder_Head + Recorder_Size - Recorder_Used) % Recorder_Size;
+  *Record = Recorder_Buffer[(Oldest + Index) % Recorder_Size];
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Link the replayer as the platform layer of the handler.
+ * @note   Send and Receive return the recorded results and Receive returns the
+ *         recorded data, so the application runs against the captured traffic
+ *         at full speed. Send data or address that differs from the trace is
+ *         counted as a mismatch. If Records is NULL, the replayer acts as a
+ *         null bus: every transfer succeeds and Receive returns zeros.
+ * @note   With PCA9534_CONFIG_PLATFORM_STATIC the driver does not call the
+ *         pointers of the handler, so the replayer is not seen by
+ *         PCA9534.c.
+ * @param  Handler: Pointer to handler
+ * @param  Records: Pointer to recorded transactions
+ * @param  Count: Number of records
+ * @retval None
+ */
+void
+PCA9534_Replayer_Init(PCA9534_Handler_t *Handler,
+                      const PCA9534_Record_t *Records, uint32_t Count)
+{
+  Replayer_Records = Records;
+  Replayer_Count = Records ? Count : 0;
+  Replayer_Index = 0;
+  Replayer_Mismatches = 0;
+
+  PCA9534_PLATFORM_LINK_INIT(Handler, NULL);
+  PCA9534_PLATFORM_LINK_DEINIT(Handler, NULL);
+  PCA9534_PLATFORM_LINK_SEND(Handler, Replayer_Send);
+  PCA9534_PLATFORM_LINK_RECEIVE(Handler, Replayer_Receive);
+}
+
+
+/**
+ * @brief  Number of transfers that did not match the trace
+ * @note   Running past the end of the trace also counts as a mismatch.
+ * @retval Number of mismatches
+ */
+uint32_t
+PCA9534_Replayer_Mismatches(void)
+{
+  return Replayer_Mismatches;
+}
+
+
+/**
+ * @brief  Feed recorded transactions directly into a platform layer (e.g. a
+ *         simulator or a null bus) at full speed.
+ * @param  Platform: Pointer to target platform layer
+ * @param  Records: Pointer to recorded transactions
+ * @param  Count: Number of records
+ * @param  Mismatches: Pointer to number of transfers whose result or received
+ *                     data differs from the trace (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Replayer_Run(const PCA9534_Platform_t *Platform,
+                     const PCA9534_Record_t *Records, uint32_t Count,
+                     uint32_t *Mismatches)
+{
+  uint8_t Data[PCA9534_RECORD_DATA_MAX] = {0};
+  uint32_t Errors = 0;
+  uint32_t i = 0;
+  int8_t Result = 0;
+
+  if (!Platform || !Platform->Send || !Platform->Receive || !Records)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < Count; i++)
+  {
+    const PCA9534_Record_t *Record = &Records[i];
+
+    // Longer transfers were truncated while recording and can not be replayed
+    if (Record->Len > PCA9534_RECORD_DATA_MAX)
+    {
+      Errors++;
+      continue;
+    }
+
+    if (Record->Dir == PCA9534_RECORD_DIR_SEND)
+    {
+      memcpy(Data, Record->Data, Record->Len);
+      Result = Platform->Send(Record->Address, Data, Record->Len);
+    }
+    else
+    {
+      Result = Platform->Receive(Record->Address, Data, Record->Len);
+      if (Result >= 0 && Record->Result >= 0 &&
+          memcmp(Data, Record->Data, Record->Len) != 0)
+        Errors++;
+    }
+
+    if ((Result < 0) != (Record->Result < 0))
+      Errors++;
+  }
+
+  if (Mismatches)
+    *Mismatches = Errors;
+
+  return PCA9534_OK;
+}
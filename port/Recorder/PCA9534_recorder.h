@@ -0,0 +1,211 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_recorder.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Bus transaction recorder and replayer for PCA9534 Driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_RECORDER_H_
+#define _PCA9534_RECORDER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534.h"
+#include <stdint.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Maximum number of data bytes kept in one record
+ */
+#define PCA9534_RECORD_DATA_MAX   4
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Transaction direction
+ */
+typedef enum PCA9534_RecordDir_e
+{
+  PCA9534_RECORD_DIR_SEND     = 0,
+  PCA9534_RECORD_DIR_RECEIVE  = 1,
+} PCA9534_RecordDir_t;
+
+/**
+ * @brief  One recorded bus transaction (12 Bytes)
+ * @note   Records are written as-is to the ring or the sink, so a trace file is
+ *         a plain array of this type.
+ */
+typedef struct PCA9534_Record_s
+{
+  // Platform GetTime value at the start of the transaction (0 if not linked)
+  uint32_t Time;
+  // Address of slave
+  uint8_t Address;
+  // PCA9534_RecordDir_t
+  uint8_t Dir;
+  // Data len in Bytes
+  uint8_t Len;
+  // Return value of the platform function
+  int8_t Result;
+  // First PCA9534_RECORD_DATA_MAX bytes of data
+  uint8_t Data[PCA9534_RECORD_DATA_MAX];
+} PCA9534_Record_t;
+
+/**
+ * @brief  Function type for streaming records out (e.g. to a file)
+ * @param  Record: Pointer to the new record
+ */
+typedef void (*PCA9534_Recorder_Sink_t)(const PCA9534_Record_t *Record);
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Insert the recorder between the handler and its platform layer.
+ * @note   The platform dependent layer of the handler must be linked before
+ *         calling this function. All handlers attached at the same time must
+ *         use the same platform layer (one bus).
+ * @note   The ring is shared by all attached handlers. It is reset only by the
+ *         first attach; Buffer, Size and Sink of later attaches are ignored
+ *         until every handler has been detached.
+ * @note   When the ring is full the oldest record is overwritten.
+ * @note   With PCA9534_CONFIG_PLATFORM_STATIC the driver does not call the
+ *         pointers of the handler, so nothing could be recorded and the
+ *         recorder is not attached.
+ * @param  Handler: Pointer to handler
+ * @param  Buffer: Pointer to ring buffer (can be NULL if Sink is used)
+ * @param  Size: Number of records in ring buffer
+ * @param  Sink: Function called for every new record (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid, the
+ *                                  platform Send or Receive differs from the
+ *                                  one of the handlers already attached, or
+ *                                  the platform functions are bound
+ *                                  statically.
+ */
+PCA9534_Result_t
+PCA9534_Recorder_Attach(PCA9534_Handler_t *Handler,
+                        PCA9534_Record_t *Buffer, uint32_t Size,
+                        PCA9534_Recorder_Sink_t Sink);
+
+
+/**
+ * @brief  Remove the recorder and restore the original platform layer.
+ * @param  Handler: Pointer to handler
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Recorder_Detach(PCA9534_Handler_t *Handler);
+
+
+/**
+ * @brief  Number of records in the ring buffer
+ * @retval Number of records
+ */
+uint32_t
+PCA9534_Recorder_Count(void);
+
+
+/**
+ * @brief  Get one record from the ring buffer
+ * @param  Index: Index of record (0 is the oldest one)
+ * @param  Record: Pointer to record
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Recorder_Get(uint32_t Index, PCA9534_Record_t *Record);
+
+
+/**
+ * @brief  Link the replayer as the platform layer of the handler.
+ * @note   Send and Receive return the recorded results and Receive returns the
+ *         recorded data, so the application runs against the captured traffic
+ *         at full speed. Send data or address that differs from the trace is
+ *         counted as a mismatch. If Records is NULL, the replayer acts as a
+ *         null bus: every transfer succeeds and Receive returns zeros.
+ * @note   With PCA9534_CONFIG_PLATFORM_STATIC the driver does not call the
+ *         pointers of the handler, so the replayer is not seen by
+ *         PCA9534.c.
+ * @param  Handler: Pointer to handler
+ * @param  Records: Pointer to recorded transactions
+ * @param  Count: Number of records
+ * @retval None
+ */
+void
+PCA9534_Replayer_Init(PCA9534_Handler_t *Handler,
+                      const PCA9534_Record_t *Records, uint32_t Count);
+
+
+/**
+ * @brief  Number of transfers that did not match the trace
+ * @note   Running past the end of the trace also counts as a mismatch.
+ * @retval Number of mismatches
+ */
+uint32_t
+PCA9534_Replayer_Mismatches(void);
+
+
+/**
+ * @brief  Feed recorded transactions directly into a platform layer (e.g. a
+ *         simulator or a null bus) at full speed.
+ * @param  Platform: Pointer to target platform layer
+ * @param  Records: Pointer to recorded transactions
+ * @param  Count: Number of records
+ * @param  Mismatches: Pointer to number of transfers whose result or received
+ *                     data differs from the trace (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Replayer_Run(const PCA9534_Platform_t *Platform,
+                     const PCA9534_Record_t *Records, uint32_t Count,
+                     uint32_t *Mismatches);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_RECORDER_H_
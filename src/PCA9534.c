@@ -31,6 +31,18 @@
 /* Includes ---------------------------------------------------------------------*/
 #include "PCA9534.h"
 #include <stdio.h>
+#if PCA9534_CONFIG_STATS
+#include <string.h>
+#endif
+#if PCA9534_CONFIG_TRACE
+#include <sys/sdt.h>
+#endif
+#if PCA9534_CONFIG_PLATFORM_STATIC
+#ifndef PCA9534_PLATFORM_HEADER
+#error "PCA9534_PLATFORM_HEADER must name the header of the static platform layer"
+#endif
+#include PCA9534_PLATFORM_HEADER
+#endif
 
 
 /* Private Constants ------------------------------------------------------------*/
@@ -42,12 +54,133 @@
 
 /**
  * @brief  Register addresses
+ * @note   On 16-bit devices the registers are paired, so the address of the
+ *         port 0 register is multiplied by the number of ports.
  */
 #define PCA9534_REG_INPUT_PORT      0x00
 #define PCA9534_REG_OUTPUT_PORT     0x01
 #define PCA9534_REG_POLARITY_INVERT 0x02
 #define PCA9534_REG_CONFIGURATION   0x03
 
+/**
+ * @brief  Agile I/O register addresses (PCAL devices)
+ * @note   They are scaled like the basic registers from 0x40, except the
+ *         Output Drive Strength registers (2 per port, 0x40 + Pos / 4) and
+ *         the Output Port Configuration register.
+ */
+#define PCA9534_REG_DRIVE_STRENGTH  0x40
+#define PCA9534_REG_INPUT_LATCH     0x42
+#define PCA9534_REG_PULL_ENABLE     0x43
+#define PCA9534_REG_PULL_SELECT     0x44
+#define PCA9534_REG_INT_MASK        0x45
+#define PCA9534_REG_INT_STATUS      0x46
+#define PCA9534_REG_OUTPUT_CONFIG   0x4F
+
+/**
+ * @brief  Power-on default values of registers
+ */
+#define PCA9534_DEFAULT_OUTPUT_PORT     0xFFFF
+#define PCA9534_DEFAULT_POLARITY_INVERT 0x0000
+#define PCA9534_DEFAULT_CONFIGURATION   0xFFFF
+#define PCA9534_DEFAULT_DRIVE_STRENGTH  0xFFFFFFFF
+#define PCA9534_DEFAULT_INPUT_LATCH     0x0000
+#define PCA9534_DEFAULT_PULL_ENABLE     0x0000
+#define PCA9534_DEFAULT_PULL_SELECT     0xFFFF
+#define PCA9534_DEFAULT_INT_MASK        0xFFFF
+#define PCA9534_DEFAULT_OUTPUT_CONFIG   0x00
+
+/**
+ * @brief  Maximum number of data bytes of a register transfer
+ */
+#define PCA9534_REG_BURST_MAX       2
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+/**
+ * @brief  Part descriptors (in order of PCA9534_Device_t)
+ */
+static const PCA9534_Part_t PCA9534_Parts[PCA9534_DEVICE_COUNT] =
+{
+  // Name      AddressBase                AddrPins Ports Regs  kHz  AutoInc Agile
+  {"PCA9534",  PCA9534_I2C_ADDRESS_BASE,  3,       1,    4,    400,  0,      0},
+  {"PCA9534A", PCA9534A_I2C_ADDRESS_BASE, 3,       1,    4,    400,  0,      0},
+  {"PCA9535",  PCA9534_I2C_ADDRESS_BASE,  3,       2,    8,    400,  1,      0},
+  {"PCA9555",  PCA9534_I2C_ADDRESS_BASE,  3,       2,    8,    400,  1,      0},
+  {"TCA9535",  PCA9534_I2C_ADDRESS_BASE,  3,       2,    8,    400,  1,      0},
+  {"PCAL9534", PCA9534_I2C_ADDRESS_BASE,  3,       1,    12,   1000, 0,      1},
+  {"PCAL6408", PCA9534_I2C_ADDRESS_BASE,  1,       1,    12,   1000, 0,      1},
+  {"PCAL9535", PCA9534_I2C_ADDRESS_BASE,  3,       2,    23,   1000, 1,      1},
+  {"PCAL6416", PCA9534_I2C_ADDRESS_BASE,  1,       2,    23,   1000, 1,      1},
+  {"PCA9554",  PCA9534_I2C_ADDRESS_BASE,  3,       1,    4,    400,  0,      0},
+  {"PCA9554A", PCA9534A_I2C_ADDRESS_BASE, 3,       1,    4,    400,  0,      0},
+  {"TCA9534",  PCA9534_I2C_ADDRESS_BASE,  3,       1,    4,    400,  0,      0},
+  {"TCA9554",  PCA9534_I2C_ADDRESS_BASE,  3,       1,    4,    400,  0,      0},
+};
+
+
+
+/* Private Macros ---------------------------------------------------------------*/
+#if PCA9534_CONFIG_STATS
+#define PCA9534_STATS_INC(HANDLER, FIELD) \
+  ((HANDLER)->Stats.FIELD++)
+#define PCA9534_STATS_BUS(HANDLER, RESULT, LEN) \
+  PCA9534_StatsBus((HANDLER), (RESULT), (LEN))
+#define PCA9534_STATS_START(HANDLER) \
+  uint32_t StatsStart = PCA9534_StatsTime(HANDLER)
+#define PCA9534_STATS_STOP(HANDLER, OP) \
+  PCA9534_StatsLatency((HANDLER), (OP), StatsStart)
+#else
+#define PCA9534_STATS_INC(HANDLER, FIELD)
+#define PCA9534_STATS_BUS(HANDLER, RESULT, LEN)
+#define PCA9534_STATS_START(HANDLER)
+#define PCA9534_STATS_STOP(HANDLER, OP)
+#endif
+
+#if PCA9534_CONFIG_TRACE
+#define PCA9534_TRACE_ENTRY(HANDLER) \
+  DTRACE_PROBE2(pca9534, func__entry, __func__, (HANDLER)->AddressI2C)
+#define PCA9534_TRACE_RETURN(HANDLER, RESULT) \
+  do \
+  { \
+    PCA9534_Result_t TraceResult = (RESULT); \
+    DTRACE_PROBE3(pca9534, func__return, __func__, (HANDLER)->AddressI2C, \
+                  TraceResult); \
+    return TraceResult; \
+  } while (0)
+#define PCA9534_TRACE_BUS(PROBE, HANDLER, REG, LEN) \
+  DTRACE_PROBE3(pca9534, PROBE, (HANDLER)->AddressI2C, (REG), (LEN))
+#define PCA9534_TRACE_BUS_RETURN(PROBE, HANDLER, REG, LEN, RESULT) \
+  DTRACE_PROBE4(pca9534, PROBE, (HANDLER)->AddressI2C, (REG), (LEN), (RESULT))
+#else
+#define PCA9534_TRACE_ENTRY(HANDLER)
+#define PCA9534_TRACE_RETURN(HANDLER, RESULT) \
+  return (RESULT)
+#define PCA9534_TRACE_BUS(PROBE, HANDLER, REG, LEN)
+#define PCA9534_TRACE_BUS_RETURN(PROBE, HANDLER, REG, LEN, RESULT)
+#endif
+
+// Transport of the device
+#if PCA9534_CONFIG_PLATFORM_STATIC
+#define PCA9534_SEND(HANDLER, DATA, LEN) \
+  PCA9534_PLATFORM_SEND((HANDLER)->AddressI2C, (DATA), (LEN))
+#define PCA9534_RECEIVE(HANDLER, DATA, LEN) \
+  PCA9534_PLATFORM_RECEIVE((HANDLER)->AddressI2C, (DATA), (LEN))
+#else
+#define PCA9534_SEND(HANDLER, DATA, LEN) \
+  (HANDLER)->Platform.Send((HANDLER)->AddressI2C, (DATA), (LEN))
+#define PCA9534_RECEIVE(HANDLER, DATA, LEN) \
+  (HANDLER)->Platform.Receive((HANDLER)->AddressI2C, (DATA), (LEN))
+#endif
+
+// Mask of the pins of the device
+#define PCA9534_PIN_MASK(HANDLER) \
+  ((uint16_t)((1UL << ((HANDLER)->Part->Ports * 8)) - 1))
+
+// Address of the port 0 register on the device
+#define PCA9534_REG_ADDRESS(HANDLER, REG) \
+  (((REG) & 0x40) | (((REG) & 0x3F) * (HANDLER)->Part->Ports))
+
 
 
 /**
@@ -55,28 +188,339 @@
                        ##### Private Functions #####
  ==================================================================================
  */
+#if PCA9534_CONFIG_STATS
+static uint32_t
+PCA9534_StatsTime(PCA9534_Handler_t *Handler)
+{
+  if (!Handler->Platform.GetTime)
+    return 0;
+
+  return Handler->Platform.GetTime();
+}
+
+static void
+PCA9534_StatsBus(PCA9534_Handler_t *Handler, int8_t Result, uint8_t Len)
+{
+  Handler->Stats.Transactions++;
+
+  switch (Result)
+  {
+  case 0:
+    Handler->Stats.Bytes += Len;
+    break;
+
+  case -2:
+    Handler->Stats.FailBusy++;
+    break;
+
+  case -3:
+    Handler->Stats.FailNAck++;
+    break;
+
+  default:
+    if (Result < 0)
+      Handler->Stats.FailError++;
+    else
+      Handler->Stats.Bytes += Len;
+    break;
+  }
+}
+
+static void
+PCA9534_StatsLatency(PCA9534_Handler_t *Handler, PCA9534_StatsOp_t Op,
+                     uint32_t Start)
+{
+  uint32_t Latency = 0;
+  uint8_t Bucket = 0;
+
+  if (!Handler->Platform.GetTime)
+    return;
+
+  Latency = Handler->Platform.GetTime() - Start;
+  while (Latency > 1 && Bucket < (PCA9534_STATS_LATENCY_BUCKETS - 1))
+  {
+    Latency >>= 1;
+    Bucket++;
+  }
+
+  Handler->Stats.Latency[Op][Bucket]++;
+}
+#endif
+
 static PCA9534_Result_t
-PCA9534_WriteReg(PCA9534_Handler_t *Handler, uint8_t Address, uint8_t Data)
+PCA9534_WriteReg(PCA9534_Handler_t *Handler, uint8_t Address,
+                 const uint8_t *Data, uint8_t Len)
 {
-  uint8_t Buffer[2] = {Address, Data};
-  if (Handler->Platform.Send(Handler->AddressI2C, Buffer, 2) < 0)
+  uint8_t Buffer[1 + PCA9534_REG_BURST_MAX];
+  int8_t Result = 0;
+  uint8_t i = 0;
+  PCA9534_STATS_START(Handler);
+
+  Buffer[0] = Address;
+  for (i = 0; i < Len; i++)
+    Buffer[i + 1] = Data[i];
+
+  Handler->ScrubCounter++;
+  PCA9534_TRACE_BUS(send__entry, Handler, Address, Len);
+  Result = PCA9534_SEND(Handler, Buffer, Len + 1);
+  PCA9534_TRACE_BUS_RETURN(send__return, Handler, Address, Len, Result);
+  PCA9534_STATS_BUS(Handler, Result, Len + 1);
+  PCA9534_STATS_STOP(Handler, PCA9534_STATS_OP_WRITE);
+  if (Result < 0)
+    return PCA9534_FAIL;
+
+  return PCA9534_OK;
+}
+
+static PCA9534_Result_t
+PCA9534_ReadReg(PCA9534_Handler_t *Handler, uint8_t Address,
+                uint8_t *Data, uint8_t Len)
+{
+  int8_t Result = 0;
+  PCA9534_STATS_START(Handler);
+
+  Handler->ScrubCounter++;
+  PCA9534_TRACE_BUS(send__entry, Handler, Address, 0);
+  Result = PCA9534_SEND(Handler, &Address, 1);
+  PCA9534_TRACE_BUS_RETURN(send__return, Handler, Address, 0, Result);
+  PCA9534_STATS_BUS(Handler, Result, 1);
+  if (Result >= 0)
+  {
+    PCA9534_TRACE_BUS(receive__entry, Handler, Address, Len);
+    Result = PCA9534_RECEIVE(Handler, Data, Len);
+    PCA9534_TRACE_BUS_RETURN(receive__return, Handler, Address, Len, Result);
+    PCA9534_STATS_BUS(Handler, Result, Len);
+  }
+  PCA9534_STATS_STOP(Handler, PCA9534_STATS_OP_READ);
+  if (Result < 0)
     return PCA9534_FAIL;
 
   return PCA9534_OK;
 }
 
 static PCA9534_Result_t
-PCA9534_ReadReg(PCA9534_Handler_t *Handler, uint8_t Address, uint8_t *Data)
+PCA9534_WritePortReg(PCA9534_Handler_t *Handler, uint8_t Address,
+                     uint16_t Data)
+{
+  uint8_t Buffer[PCA9534_REG_BURST_MAX] = {(uint8_t)Data, (uint8_t)(Data >> 8)};
+  uint8_t Port = 0;
+
+  Address = PCA9534_REG_ADDRESS(Handler, Address);
+  if (Handler->Part->AutoIncrement)
+    return PCA9534_WriteReg(Handler, Address, Buffer, Handler->Part->Ports);
+
+  for (Port = 0; Port < Handler->Part->Ports; Port++)
+  {
+    if (PCA9534_WriteReg(Handler, Address + Port,
+                         &Buffer[Port], 1) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  return PCA9534_OK;
+}
+
+static PCA9534_Result_t
+PCA9534_ReadPortReg(PCA9534_Handler_t *Handler, uint8_t Address,
+                    uint16_t *Data)
+{
+  uint8_t Buffer[PCA9534_REG_BURST_MAX] = {0};
+  uint8_t Port = 0;
+
+  Address = PCA9534_REG_ADDRESS(Handler, Address);
+  if (Handler->Part->AutoIncrement)
+  {
+    if (PCA9534_ReadReg(Handler, Address,
+                        Buffer, Handler->Part->Ports) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+  else
+  {
+    for (Port = 0; Port < Handler->Part->Ports; Port++)
+    {
+      if (PCA9534_ReadReg(Handler, Address + Port,
+                          &Buffer[Port], 1) != PCA9534_OK)
+        return PCA9534_FAIL;
+    }
+  }
+
+  *Data = Buffer[0] | ((uint16_t)Buffer[1] << 8);
+
+  return PCA9534_OK;
+}
+
+static PCA9534_Result_t
+PCA9534_SetupHandler(PCA9534_Handler_t *Handler, PCA9534_Device_t Device,
+                     uint8_t Address)
+{
+  if (!Handler)
+    return PCA9534_INVALID_PARAM;
+
+  if ((unsigned)Device >= PCA9534_DEVICE_COUNT)
+    return PCA9534_INVALID_PARAM;
+  Handler->Part = &PCA9534_Parts[Device];
+  Handler->Device = Device;
+
+  if (PCA9534_SetAddressI2C(Handler, Address) != PCA9534_OK)
+    return PCA9534_INVALID_PARAM;
+
+#if !PCA9534_CONFIG_PLATFORM_STATIC
+  if (!Handler->Platform.Send || !Handler->Platform.Receive)
+    return PCA9534_INVALID_PARAM;
+#endif
+
+  return PCA9534_OK;
+}
+
+static PCA9534_Result_t
+PCA9534_ReadDriveReg(PCA9534_Handler_t *Handler, uint8_t Port, uint8_t *Data)
+{
+  uint8_t Address = PCA9534_REG_DRIVE_STRENGTH + Port * 2;
+
+  if (Handler->Part->AutoIncrement)
+    return PCA9534_ReadReg(Handler, Address, Data, 2);
+
+  if (PCA9534_ReadReg(Handler, Address, &Data[0], 1) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  return PCA9534_ReadReg(Handler, Address + 1, &Data[1], 1);
+}
+
+static PCA9534_Result_t
+PCA9534_ReadBack(PCA9534_Handler_t *Handler)
+{
+  uint8_t Buffer[2] = {0};
+  uint8_t Port = 0;
+
+  if (PCA9534_ReadPortReg(Handler, PCA9534_REG_OUTPUT_PORT,
+                          &Handler->RegOutput) != PCA9534_OK ||
+      PCA9534_ReadPortReg(Handler, PCA9534_REG_POLARITY_INVERT,
+                          &Handler->RegPolarity) != PCA9534_OK ||
+      PCA9534_ReadPortReg(Handler, PCA9534_REG_CONFIGURATION,
+                          &Handler->RegConfig) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  if (!Handler->Part->Agile)
+    return PCA9534_OK;
+
+  Handler->RegDrive = PCA9534_DEFAULT_DRIVE_STRENGTH;
+  for (Port = 0; Port < Handler->Part->Ports; Port++)
+  {
+    if (PCA9534_ReadDriveReg(Handler, Port, Buffer) != PCA9534_OK)
+      return PCA9534_FAIL;
+    Handler->RegDrive &= ~((uint32_t)0xFFFF << (Port * 16));
+    Handler->RegDrive |= ((uint32_t)Buffer[0] | ((uint32_t)Buffer[1] << 8)) <<
+                         (Port * 16);
+  }
+
+  if (PCA9534_ReadPortReg(Handler, PCA9534_REG_INPUT_LATCH,
+                          &Handler->RegLatch) != PCA9534_OK ||
+      PCA9534_ReadPortReg(Handler, PCA9534_REG_PULL_ENABLE,
+                          &Handler->RegPullEnable) != PCA9534_OK ||
+      PCA9534_ReadPortReg(Handler, PCA9534_REG_PULL_SELECT,
+                          &Handler->RegPullSelect) != PCA9534_OK ||
+      PCA9534_ReadPortReg(Handler, PCA9534_REG_INT_MASK,
+                          &Handler->RegIntMask) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  return PCA9534_ReadReg(Handler, PCA9534_REG_OUTPUT_CONFIG,
+                         &Handler->RegOutputConfig, 1);
+}
+
+static PCA9534_Result_t
+PCA9534_WriteDriveReg(PCA9534_Handler_t *Handler, uint8_t Port,
+                      const uint8_t *Data)
+{
+  uint8_t Address = PCA9534_REG_DRIVE_STRENGTH + Port * 2;
+
+  if (Handler->Part->AutoIncrement)
+    return PCA9534_WriteReg(Handler, Address, Data, 2);
+
+  if (PCA9534_WriteReg(Handler, Address, &Data[0], 1) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  return PCA9534_WriteReg(Handler, Address + 1, &Data[1], 1);
+}
+
+static PCA9534_Result_t
+PCA9534_ReplayReg(PCA9534_Handler_t *Handler, uint8_t Reset, uint8_t Address,
+                  uint16_t Value, uint16_t Default)
+{
+  if (Reset && Value == (Default & PCA9534_PIN_MASK(Handler)))
+    return PCA9534_OK;
+
+  return PCA9534_WritePortReg(Handler, Address, Value);
+}
+
+static PCA9534_Result_t
+PCA9534_ReplayAgile(PCA9534_Handler_t *Handler, uint8_t Reset)
 {
-  if (Handler->Platform.Send(Handler->AddressI2C, &Address, 1) < 0)
+  uint8_t Buffer[2] = {0};
+  uint8_t Port = 0;
+
+  for (Port = 0; Port < Handler->Part->Ports; Port++)
+  {
+    Buffer[0] = (uint8_t)(Handler->RegDrive >> (Port * 16));
+    Buffer[1] = (uint8_t)(Handler->RegDrive >> (Port * 16 + 8));
+    if (Reset && Buffer[0] == 0xFF && Buffer[1] == 0xFF)
+      continue;
+    if (PCA9534_WriteDriveReg(Handler, Port, Buffer) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  if (!Reset || Handler->RegOutputConfig != PCA9534_DEFAULT_OUTPUT_CONFIG)
+  {
+    if (PCA9534_WriteReg(Handler, PCA9534_REG_OUTPUT_CONFIG,
+                         &Handler->RegOutputConfig, 1) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  if (PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_PULL_SELECT,
+                        Handler->RegPullSelect,
+                        PCA9534_DEFAULT_PULL_SELECT) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  if (PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_PULL_ENABLE,
+                        Handler->RegPullEnable,
+                        PCA9534_DEFAULT_PULL_ENABLE) != PCA9534_OK)
     return PCA9534_FAIL;
 
-  if (Handler->Platform.Receive(Handler->AddressI2C, Data, 1) < 0)
+  if (PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_INPUT_LATCH,
+                        Handler->RegLatch,
+                        PCA9534_DEFAULT_INPUT_LATCH) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  if (PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_INT_MASK,
+                        Handler->RegIntMask,
+                        PCA9534_DEFAULT_INT_MASK) != PCA9534_OK)
     return PCA9534_FAIL;
 
   return PCA9534_OK;
 }
 
+static PCA9534_Result_t
+PCA9534_Replay(PCA9534_Handler_t *Handler, uint8_t Reset)
+{
+  if (PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_OUTPUT_PORT,
+                        Handler->RegOutput,
+                        PCA9534_DEFAULT_OUTPUT_PORT) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  if (PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_POLARITY_INVERT,
+                        Handler->RegPolarity,
+                        PCA9534_DEFAULT_POLARITY_INVERT) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  if (Handler->Part->Agile)
+  {
+    if (PCA9534_ReplayAgile(Handler, Reset) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  // Configuration is the last one, so outputs are enabled fully configured
+  return PCA9534_ReplayReg(Handler, Reset, PCA9534_REG_CONFIGURATION,
+                           Handler->RegConfig, PCA9534_DEFAULT_CONFIGURATION);
+}
+
 
 
 /**
@@ -91,7 +535,7 @@ PCA9534_ReadReg(PCA9534_Handler_t *Handler, uint8_t Address, uint8_t *Data)
  *         layer and before using other functions.
  * @param  Handler: Pointer to handler
  * @param  Device: Device type
- * @param  Address: Address pins state (0 <= Address <= 7)
+ * @param  Address: Address pins state (0 <= Address < 2^AddressPins of part)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
  *         - PCA9534_FAIL: Failed to send or receive data.
@@ -101,37 +545,65 @@ PCA9534_Result_t
 PCA9534_Init(PCA9534_Handler_t *Handler, PCA9534_Device_t Device,
              uint8_t Address)
 {
-  if (!Handler)
-    return PCA9534_INVALID_PARAM;
-
-  if (Device != PCA9534_DEVICE_PCA9534 &&
-      Device != PCA9534_DEVICE_PCA9534A)
-    return PCA9534_INVALID_PARAM;
-  Handler->Device = Device;
-
-  if (PCA9534_SetAddressI2C(Handler, Address) != PCA9534_OK)
+  if (PCA9534_SetupHandler(Handler, Device, Address) != PCA9534_OK)
     return PCA9534_INVALID_PARAM;
 
-  if (!Handler->Platform.Send || !Handler->Platform.Receive)
-    return PCA9534_INVALID_PARAM;
+  PCA9534_TRACE_ENTRY(Handler);
 
   if (Handler->Platform.Init)
   {
     if (Handler->Platform.Init() < 0)
-      return PCA9534_FAIL;
+      PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
   }
 
   // Reset all registers to default values
-  if (PCA9534_WriteReg(Handler, PCA9534_REG_OUTPUT_PORT, 0xFF) != PCA9534_OK)
-    return PCA9534_FAIL;
+  Handler->RegOutput = PCA9534_DEFAULT_OUTPUT_PORT & PCA9534_PIN_MASK(Handler);
+  Handler->RegPolarity = PCA9534_DEFAULT_POLARITY_INVERT &
+                         PCA9534_PIN_MASK(Handler);
+  Handler->RegConfig = PCA9534_DEFAULT_CONFIGURATION & PCA9534_PIN_MASK(Handler);
+  Handler->RegDrive = PCA9534_DEFAULT_DRIVE_STRENGTH;
+  Handler->RegLatch = PCA9534_DEFAULT_INPUT_LATCH;
+  Handler->RegPullEnable = PCA9534_DEFAULT_PULL_ENABLE;
+  Handler->RegPullSelect = PCA9534_DEFAULT_PULL_SELECT & PCA9534_PIN_MASK(Handler);
+  Handler->RegIntMask = PCA9534_DEFAULT_INT_MASK & PCA9534_PIN_MASK(Handler);
+  Handler->RegOutputConfig = PCA9534_DEFAULT_OUTPUT_CONFIG;
+  Handler->ScrubCounter = 0;
 
-  if (PCA9534_WriteReg(Handler, PCA9534_REG_POLARITY_INVERT, 0x00) != PCA9534_OK)
-    return PCA9534_FAIL;
+  PCA9534_TRACE_RETURN(Handler, PCA9534_Replay(Handler, 0));
+}
 
-  if (PCA9534_WriteReg(Handler, PCA9534_REG_CONFIGURATION, 0xFF) != PCA9534_OK)
-    return PCA9534_FAIL;
 
-  return PCA9534_OK;
+/**
+ * @brief  Initializer function for a device that is already running
+ * @note   Unlike PCA9534_Init, no register is written: the shadow copies are
+ *         read back from the device, so its outputs and configuration are
+ *         kept. Use it to take over a device without glitching its pins.
+ * @param  Handler: Pointer to handler
+ * @param  Device: Device type
+ * @param  Address: Address pins state (0 <= Address < 2^AddressPins of part)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: Invalid parameter.
+ */
+PCA9534_Result_t
+PCA9534_InitFromDevice(PCA9534_Handler_t *Handler, PCA9534_Device_t Device,
+                       uint8_t Address)
+{
+  if (PCA9534_SetupHandler(Handler, Device, Address) != PCA9534_OK)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (Handler->Platform.Init)
+  {
+    if (Handler->Platform.Init() < 0)
+      PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  }
+
+  Handler->ScrubCounter = 0;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_ReadBack(Handler));
 }
 
 
@@ -148,17 +620,20 @@ PCA9534_DeInit(PCA9534_Handler_t *Handler)
   if (!Handler)
     return PCA9534_INVALID_PARAM;
 
+  PCA9534_TRACE_ENTRY(Handler);
+
   if (Handler->Platform.DeInit)
-    return ((Handler->Platform.DeInit() >= 0) ? PCA9534_OK : PCA9534_FAIL);
+    PCA9534_TRACE_RETURN(Handler, ((Handler->Platform.DeInit() >= 0) ?
+                                   PCA9534_OK : PCA9534_FAIL));
 
-  return PCA9534_OK;
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
 }
 
 
 /**
  * @brief  Set I2C Address
  * @param  Handler: Pointer to handler
- * @param  Address: Address pins state (0 <= Address <= 7)
+ * @param  Address: Address pins state (0 <= Address < 2^AddressPins of part)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
  *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
@@ -166,28 +641,72 @@ PCA9534_DeInit(PCA9534_Handler_t *Handler)
 PCA9534_Result_t
 PCA9534_SetAddressI2C(PCA9534_Handler_t *Handler, uint8_t Address)
 {
-  if (Address > 7)
+  if ((unsigned)Handler->Device >= PCA9534_DEVICE_COUNT)
     return PCA9534_INVALID_PARAM;
 
-  switch (Handler->Device)
-  {
-  case PCA9534_DEVICE_PCA9534:
-    Handler->AddressI2C = PCA9534_I2C_ADDRESS_BASE | Address;
-    break;
+  if (Address >= (1 << PCA9534_Parts[Handler->Device].AddressPins))
+    return PCA9534_INVALID_PARAM;
 
-  case PCA9534_DEVICE_PCA9534A:
-    Handler->AddressI2C = PCA9534A_I2C_ADDRESS_BASE | Address;
-    break;
-  
-  default:
+  Handler->AddressI2C = PCA9534_Parts[Handler->Device].AddressBase | Address;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Get the descriptor of a part
+ * @param  Device: Device type
+ * @retval Pointer to descriptor (NULL if Device is invalid)
+ */
+const PCA9534_Part_t *
+PCA9534_GetPart(PCA9534_Device_t Device)
+{
+  if ((unsigned)Device >= PCA9534_DEVICE_COUNT)
+    return NULL;
+
+  return &PCA9534_Parts[Device];
+}
+
+
+/**
+ * @brief  Fastest legal SCL clock of a bus
+ * @note   Every device on a bus sees all the traffic, so the bus must not run
+ *         faster than its slowest device.
+ * @param  Handlers: Pointer to array of pointers to initialized handlers
+ * @param  Count: Number of handlers
+ * @param  Clock: Pointer to clock in kHz
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_GetBusClock(PCA9534_Handler_t **Handlers, uint8_t Count,
+                    uint16_t *Clock)
+{
+  uint16_t Min = 0xFFFF;
+  uint8_t i = 0;
+
+  if (!Handlers || !Count || !Clock)
     return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < Count; i++)
+  {
+    if (!Handlers[i] || !Handlers[i]->Part)
+      return PCA9534_INVALID_PARAM;
+
+    if (Handlers[i]->Part->MaxClock < Min)
+      Min = Handlers[i]->Part->MaxClock;
   }
 
+  *Clock = Min;
+
   return PCA9534_OK;
 }
 
+
 /**
  * @brief  Set direction of pins
+ * @note   On 16-bit devices only port 0 is changed.
  * @param  Handler: Pointer to handler
  * @param  Dir: Direction of pins (1: Output, 0: Input)
  * @retval PCA9534_Result_t
@@ -197,17 +716,20 @@ PCA9534_SetAddressI2C(PCA9534_Handler_t *Handler, uint8_t Address)
 PCA9534_Result_t
 PCA9534_SetDir(PCA9534_Handler_t *Handler, uint8_t Dir)
 {
-  Dir = ~Dir;
-  if (PCA9534_WriteReg(Handler, PCA9534_REG_CONFIGURATION, Dir) != PCA9534_OK)
-    return PCA9534_FAIL;
-  return PCA9534_OK;
+  uint16_t Reg = ~Handler->RegConfig & 0xFF00;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_STATS_INC(Handler, CacheHits);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_SetDirAll(Handler, Reg | Dir));
 }
 
 
 /**
  * @brief  Set the direction of one bit
  * @param  Handler: Pointer to handler
- * @param  Pos: Position of bit (0 <= Pos <= 7)
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
  * @param  Dir: Direction of bit (1: Output, 0: Input)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
@@ -217,24 +739,27 @@ PCA9534_SetDir(PCA9534_Handler_t *Handler, uint8_t Dir)
 PCA9534_Result_t
 PCA9534_SetDirOne(PCA9534_Handler_t *Handler, uint8_t Pos, uint8_t Dir)
 {
-  if (Pos > 7)
+  uint16_t Reg = Handler->RegConfig;
+
+  if (Pos >= Handler->Part->Ports * 8)
     return PCA9534_INVALID_PARAM;
 
-  uint8_t Reg = 0;
-  if (PCA9534_ReadReg(Handler, PCA9534_REG_CONFIGURATION, &Reg) != PCA9534_OK)
-    return PCA9534_FAIL;
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_STATS_INC(Handler, CacheHits);
 
   if (Dir)
     Reg &= ~(1 << Pos);
   else
     Reg |= (1 << Pos);
 
-  return PCA9534_SetDir(Handler, Reg);
+  PCA9534_TRACE_RETURN(Handler, PCA9534_SetDirAll(Handler, ~Reg));
 }
 
 
 /**
  * @brief  Read data from the device
+ * @note   On 16-bit devices only port 0 is read.
  * @param  Handler: Pointer to handler
  * @param  Data: Pointer to data
  * @retval PCA9534_Result_t
@@ -248,15 +773,18 @@ PCA9534_Read(PCA9534_Handler_t *Handler, uint8_t *Data)
   if (!Data)
     return PCA9534_INVALID_PARAM;
 
-  if (PCA9534_ReadReg(Handler, PCA9534_REG_INPUT_PORT, Data) != PCA9534_OK)
-    return PCA9534_FAIL;
+  PCA9534_TRACE_ENTRY(Handler);
 
-  return PCA9534_OK;
+  if (PCA9534_ReadReg(Handler, PCA9534_REG_INPUT_PORT, Data, 1) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
 }
 
 
 /**
  * @brief  Write data to the device
+ * @note   On 16-bit devices only port 0 is changed.
  * @param  Handler: Pointer to handler
  * @param  Data: Data to write
  * @retval PCA9534_Result_t
@@ -266,17 +794,20 @@ PCA9534_Read(PCA9534_Handler_t *Handler, uint8_t *Data)
 PCA9534_Result_t
 PCA9534_Write(PCA9534_Handler_t *Handler, uint8_t Data)
 {
-  if (PCA9534_WriteReg(Handler, PCA9534_REG_OUTPUT_PORT, Data) != PCA9534_OK)
-    return PCA9534_FAIL;
+  uint16_t Reg = Handler->RegOutput & 0xFF00;
 
-  return PCA9534_OK;
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_STATS_INC(Handler, CacheHits);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_WriteAll(Handler, Reg | Data));
 }
 
 
 /**
  * @brief  Write data to the one bit
  * @param  Handler: Pointer to handler
- * @param  Pos: Position of bit (0 <= Pos <= 7)
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
  * @param  Value: Value to write (1: High, 0: Low)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
@@ -286,24 +817,27 @@ PCA9534_Write(PCA9534_Handler_t *Handler, uint8_t Data)
 PCA9534_Result_t
 PCA9534_WriteOne(PCA9534_Handler_t *Handler, uint8_t Pos, uint8_t Value)
 {
-  if (Pos > 7)
+  uint16_t Reg = Handler->RegOutput;
+
+  if (Pos >= Handler->Part->Ports * 8)
     return PCA9534_INVALID_PARAM;
 
-  uint8_t Reg = 0;
-  if (PCA9534_ReadReg(Handler, PCA9534_REG_OUTPUT_PORT, &Reg) != PCA9534_OK)
-    return PCA9534_FAIL;
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_STATS_INC(Handler, CacheHits);
 
   if (Value)
     Reg |= (1 << Pos);
   else
     Reg &= ~(1 << Pos);
 
-  return PCA9534_Write(Handler, Reg);
+  PCA9534_TRACE_RETURN(Handler, PCA9534_WriteAll(Handler, Reg));
 }
 
 
 /**
  * @brief  Toggle the output bits
+ * @note   On 16-bit devices only port 0 is changed.
  * @param  Handler: Pointer to handler
  * @param  Mask: Mask of bits to toggle
  * @retval PCA9534_Result_t
@@ -313,19 +847,16 @@ PCA9534_WriteOne(PCA9534_Handler_t *Handler, uint8_t Pos, uint8_t Value)
 PCA9534_Result_t
 PCA9534_Toggle(PCA9534_Handler_t *Handler, uint8_t Mask)
 {
-  uint8_t Reg = 0;
-  if (PCA9534_ReadReg(Handler, PCA9534_REG_OUTPUT_PORT, &Reg) != PCA9534_OK)
-    return PCA9534_FAIL;
+  PCA9534_TRACE_ENTRY(Handler);
 
-  Reg ^= Mask;
-  return PCA9534_Write(Handler, Reg);
+  PCA9534_TRACE_RETURN(Handler, PCA9534_ToggleAll(Handler, Mask));
 }
 
 
 /**
  * @brief  Toggle the one bit
  * @param  Handler: Pointer to handler
- * @param  Pos: Position of bit (0 <= Pos <= 7)
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
  *         - PCA9534_FAIL: Failed to send or receive data.
@@ -334,9 +865,532 @@ PCA9534_Toggle(PCA9534_Handler_t *Handler, uint8_t Mask)
 PCA9534_Result_t
 PCA9534_ToggleOne(PCA9534_Handler_t *Handler, uint8_t Pos)
 {
-  if (Pos > 7)
+  uint16_t Mask = 0;
+
+  if (Pos >= Handler->Part->Ports * 8)
     return PCA9534_INVALID_PARAM;
 
-  uint8_t Mask = 1 << Pos;
-  return PCA9534_Toggle(Handler, Mask);
+  Mask = 1 << Pos;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_ToggleAll(Handler, Mask));
+}
+
+
+/**
+ * @brief  Set direction of all pins in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Dir: Direction of pins (1: Output, 0: Input), port 0 in the low byte
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ */
+PCA9534_Result_t
+PCA9534_SetDirAll(PCA9534_Handler_t *Handler, uint16_t Dir)
+{
+  PCA9534_TRACE_ENTRY(Handler);
+
+  Dir = ~Dir & PCA9534_PIN_MASK(Handler);
+  if (PCA9534_WritePortReg(Handler, PCA9534_REG_CONFIGURATION, Dir) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegConfig = Dir;
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Read all ports of the device in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Data: Pointer to data (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: Invalid parameter.
+ */
+PCA9534_Result_t
+PCA9534_ReadAll(PCA9534_Handler_t *Handler, uint16_t *Data)
+{
+  if (!Data)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (PCA9534_ReadPortReg(Handler, PCA9534_REG_INPUT_PORT, Data) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Write all ports of the device in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Data: Data to write (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ */
+PCA9534_Result_t
+PCA9534_WriteAll(PCA9534_Handler_t *Handler, uint16_t Data)
+{
+  PCA9534_TRACE_ENTRY(Handler);
+
+  Data &= PCA9534_PIN_MASK(Handler);
+  if (PCA9534_WritePortReg(Handler, PCA9534_REG_OUTPUT_PORT, Data) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegOutput = Data;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Toggle the output bits of all ports in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Mask: Mask of bits to toggle (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ */
+PCA9534_Result_t
+PCA9534_ToggleAll(PCA9534_Handler_t *Handler, uint16_t Mask)
+{
+  uint16_t Reg = Handler->RegOutput;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_STATS_INC(Handler, CacheHits);
+
+  Reg ^= Mask;
+  PCA9534_TRACE_RETURN(Handler, PCA9534_WriteAll(Handler, Reg));
+}
+
+
+/**
+ * @brief  Enable the input latch of pins
+ * @note   A latched pin keeps a change in the Input Port register until it is
+ *         read, so short pulses between two reads are not lost.
+ * @param  Handler: Pointer to handler
+ * @param  Latch: Mask of latched pins (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: The device has no Agile I/O registers.
+ */
+PCA9534_Result_t
+PCA9534_SetInputLatch(PCA9534_Handler_t *Handler, uint16_t Latch)
+{
+  if (!Handler->Part->Agile)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  Latch &= PCA9534_PIN_MASK(Handler);
+  if (PCA9534_WritePortReg(Handler, PCA9534_REG_INPUT_LATCH, Latch) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegLatch = Latch;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Set the pull-up/pull-down resistors of pins
+ * @param  Handler: Pointer to handler
+ * @param  Enable: Mask of pins with a pull resistor (port 0 in the low byte)
+ * @param  Up: Direction of pull resistors (1: Pull-up, 0: Pull-down)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: The device has no Agile I/O registers.
+ */
+PCA9534_Result_t
+PCA9534_SetPull(PCA9534_Handler_t *Handler, uint16_t Enable, uint16_t Up)
+{
+  if (!Handler->Part->Agile)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  Enable &= PCA9534_PIN_MASK(Handler);
+  Up &= PCA9534_PIN_MASK(Handler);
+
+  // Direction first, so an enabled resistor never pulls the wrong way
+  if (Up != Handler->RegPullSelect)
+  {
+    if (PCA9534_WritePortReg(Handler, PCA9534_REG_PULL_SELECT, Up) != PCA9534_OK)
+      PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+    Handler->RegPullSelect = Up;
+  }
+
+  if (PCA9534_WritePortReg(Handler, PCA9534_REG_PULL_ENABLE, Enable) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegPullEnable = Enable;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Set the output drive strength of one bit
+ * @param  Handler: Pointer to handler
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
+ * @param  Drive: Drive strength
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SetDriveStrength(PCA9534_Handler_t *Handler, uint8_t Pos,
+                         PCA9534_Drive_t Drive)
+{
+  uint32_t Reg = Handler->RegDrive;
+  uint8_t Data = 0;
+
+  if (!Handler->Part->Agile || Pos >= Handler->Part->Ports * 8 ||
+      Drive > PCA9534_DRIVE_1_00)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  PCA9534_STATS_INC(Handler, CacheHits);
+
+  Reg &= ~(0x03UL << (Pos * 2));
+  Reg |= (uint32_t)Drive << (Pos * 2);
+
+  // Only the register that holds the pin is written
+  Data = (uint8_t)(Reg >> ((Pos / 4) * 8));
+  if (PCA9534_WriteReg(Handler, PCA9534_REG_DRIVE_STRENGTH + Pos / 4,
+                       &Data, 1) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegDrive = Reg;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Set the output stage of ports
+ * @param  Handler: Pointer to handler
+ * @param  Ports: Mask of open-drain ports (bit 0: Port 0, bit 1: Port 1),
+ *                the other ports are push-pull
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SetOpenDrain(PCA9534_Handler_t *Handler, uint8_t Ports)
+{
+  if (!Handler->Part->Agile || Ports >= (1 << Handler->Part->Ports))
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (PCA9534_WriteReg(Handler, PCA9534_REG_OUTPUT_CONFIG,
+                       &Ports, 1) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegOutputConfig = Ports;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Enable the interrupt of pins
+ * @param  Handler: Pointer to handler
+ * @param  Enable: Mask of pins that assert INT (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: The device has no Agile I/O registers.
+ */
+PCA9534_Result_t
+PCA9534_SetIntEnable(PCA9534_Handler_t *Handler, uint16_t Enable)
+{
+  uint16_t Mask = ~Enable & PCA9534_PIN_MASK(Handler);
+
+  if (!Handler->Part->Agile)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (PCA9534_WritePortReg(Handler, PCA9534_REG_INT_MASK, Mask) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+  Handler->RegIntMask = Mask;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Read the interrupt status
+ * @note   The status is cleared by reading the input port.
+ * @param  Handler: Pointer to handler
+ * @param  Status: Pointer to mask of pins that caused the interrupt
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_GetIntStatus(PCA9534_Handler_t *Handler, uint16_t *Status)
+{
+  if (!Status || !Handler->Part->Agile)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (PCA9534_ReadPortReg(Handler, PCA9534_REG_INT_STATUS, Status) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+/**
+ * @brief  Handle an interrupt of the device
+ * @note   The interrupt status and then the input port are read, which
+ *         clears the interrupt and the input latch. No diff against a
+ *         previous input value is needed to find the changed pins.
+ * @param  Handler: Pointer to handler
+ * @param  Status: Pointer to mask of pins that caused the interrupt
+ * @param  Data: Pointer to input data (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_ReadInt(PCA9534_Handler_t *Handler, uint16_t *Status, uint16_t *Data)
+{
+  if (!Status || !Data || !Handler->Part->Agile)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (PCA9534_ReadPortReg(Handler, PCA9534_REG_INT_STATUS, Status) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  if (PCA9534_ReadPortReg(Handler, PCA9534_REG_INPUT_PORT, Data) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+
+/**
+ * @brief  Set the scrub interval
+ * @note   One scrub costs at most one register read, so the scrub takes about
+ *         1/Interval of the bus transactions issued by the driver. Skipped
+ *         calls of PCA9534_Scrub are counted as idle bus slots, so an idle
+ *         device is still scrubbed every Interval calls.
+ * @param  Handler: Pointer to handler
+ * @param  Interval: Bus transactions between two scrubs (0: Disable scrub)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SetScrubInterval(PCA9534_Handler_t *Handler, uint16_t Interval)
+{
+  if (!Handler)
+    return PCA9534_INVALID_PARAM;
+
+  Handler->ScrubInterval = Interval;
+  Handler->ScrubCounter = 0;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Rate-limited check for device reset or re-plug
+ * @note   The first register whose shadow differs from its power-on default is
+ *         read back and compared. On mismatch the registers are rewritten from
+ *         the shadow copy. If the device was reset, only the registers that
+ *         differ from their power-on defaults are written (Output first, so
+ *         the outputs are driven with the right level when enabled).
+ * @param  Handler: Pointer to handler
+ * @param  Restored: Pointer to a flag set to 1 if the registers were rewritten
+ *                   (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: Invalid parameter.
+ */
+PCA9534_Result_t
+PCA9534_Scrub(PCA9534_Handler_t *Handler, uint8_t *Restored)
+{
+  uint16_t Mask = 0;
+  uint8_t RegAddress = 0;
+  uint16_t Expected = 0;
+  uint16_t Default = 0;
+  uint16_t Reg = 0;
+  uint16_t Drive = 0;
+  uint8_t Buffer[2] = {0};
+  uint8_t Port = 0;
+
+  if (!Handler)
+    return PCA9534_INVALID_PARAM;
+
+  PCA9534_TRACE_ENTRY(Handler);
+
+  if (Restored)
+    *Restored = 0;
+
+  if (!Handler->ScrubInterval)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+
+  if (Handler->ScrubCounter < Handler->ScrubInterval)
+  {
+    Handler->ScrubCounter++;
+    PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+  }
+  Handler->ScrubCounter = 0;
+  Mask = PCA9534_PIN_MASK(Handler);
+
+  // A reset can only be seen on a register that is not at its default value
+  if (Handler->RegConfig != (PCA9534_DEFAULT_CONFIGURATION & Mask))
+  {
+    RegAddress = PCA9534_REG_CONFIGURATION;
+    Expected = Handler->RegConfig;
+    Default = PCA9534_DEFAULT_CONFIGURATION & Mask;
+  }
+  else if (Handler->RegOutput != (PCA9534_DEFAULT_OUTPUT_PORT & Mask))
+  {
+    RegAddress = PCA9534_REG_OUTPUT_PORT;
+    Expected = Handler->RegOutput;
+    Default = PCA9534_DEFAULT_OUTPUT_PORT & Mask;
+  }
+  else if (Handler->RegPolarity != (PCA9534_DEFAULT_POLARITY_INVERT & Mask))
+  {
+    RegAddress = PCA9534_REG_POLARITY_INVERT;
+    Expected = Handler->RegPolarity;
+    Default = PCA9534_DEFAULT_POLARITY_INVERT & Mask;
+  }
+  else if (Handler->Part->Agile &&
+           Handler->RegIntMask != (PCA9534_DEFAULT_INT_MASK & Mask))
+  {
+    RegAddress = PCA9534_REG_INT_MASK;
+    Expected = Handler->RegIntMask;
+    Default = PCA9534_DEFAULT_INT_MASK & Mask;
+  }
+  else if (Handler->Part->Agile &&
+           Handler->RegPullEnable != (PCA9534_DEFAULT_PULL_ENABLE & Mask))
+  {
+    RegAddress = PCA9534_REG_PULL_ENABLE;
+    Expected = Handler->RegPullEnable;
+    Default = PCA9534_DEFAULT_PULL_ENABLE & Mask;
+  }
+  else if (Handler->Part->Agile &&
+           Handler->RegPullSelect != (PCA9534_DEFAULT_PULL_SELECT & Mask))
+  {
+    RegAddress = PCA9534_REG_PULL_SELECT;
+    Expected = Handler->RegPullSelect;
+    Default = PCA9534_DEFAULT_PULL_SELECT & Mask;
+  }
+  else if (Handler->Part->Agile &&
+           Handler->RegLatch != (PCA9534_DEFAULT_INPUT_LATCH & Mask))
+  {
+    RegAddress = PCA9534_REG_INPUT_LATCH;
+    Expected = Handler->RegLatch;
+    Default = PCA9534_DEFAULT_INPUT_LATCH & Mask;
+  }
+  else if (Handler->Part->Agile &&
+           Handler->RegOutputConfig != PCA9534_DEFAULT_OUTPUT_CONFIG)
+  {
+    RegAddress = PCA9534_REG_OUTPUT_CONFIG;
+    Expected = Handler->RegOutputConfig;
+    Default = PCA9534_DEFAULT_OUTPUT_CONFIG;
+  }
+  else if (Handler->Part->Agile)
+  {
+    // Drive strength has 2 registers per port, the first changed one is read
+    for (Port = 0; Port < Handler->Part->Ports; Port++)
+    {
+      Drive = (uint16_t)(Handler->RegDrive >> (Port * 16));
+      if (Drive != (uint16_t)PCA9534_DEFAULT_DRIVE_STRENGTH)
+        break;
+    }
+    if (Port == Handler->Part->Ports)
+      PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+
+    RegAddress = PCA9534_REG_DRIVE_STRENGTH;
+    Expected = Drive;
+    Default = (uint16_t)PCA9534_DEFAULT_DRIVE_STRENGTH;
+  }
+  else
+    PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+
+  if (RegAddress == PCA9534_REG_DRIVE_STRENGTH)
+  {
+    if (PCA9534_ReadDriveReg(Handler, Port, Buffer) != PCA9534_OK)
+      PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+    Reg = (uint16_t)(Buffer[0] | (Buffer[1] << 8));
+  }
+  else if (RegAddress == PCA9534_REG_OUTPUT_CONFIG)
+  {
+    if (PCA9534_ReadReg(Handler, RegAddress, Buffer, 1) != PCA9534_OK)
+      PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+    Reg = Buffer[0];
+  }
+  else if (PCA9534_ReadPortReg(Handler, RegAddress, &Reg) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  if (Reg == Expected)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+
+  if (PCA9534_Replay(Handler, (Reg == Default)) != PCA9534_OK)
+    PCA9534_TRACE_RETURN(Handler, PCA9534_FAIL);
+
+  if (Restored)
+    *Restored = 1;
+
+  PCA9534_TRACE_RETURN(Handler, PCA9534_OK);
+}
+
+
+
+#if PCA9534_CONFIG_STATS
+/**
+ * @brief  Take a snapshot of performance counters
+ * @param  Handler: Pointer to handler
+ * @param  Stats: Pointer to snapshot
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_GetStats(PCA9534_Handler_t *Handler, PCA9534_Stats_t *Stats)
+{
+  if (!Handler || !Stats)
+    return PCA9534_INVALID_PARAM;
+
+  *Stats = Handler->Stats;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Reset performance counters
+ * @param  Handler: Pointer to handler
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_ResetStats(PCA9534_Handler_t *Handler)
+{
+  if (!Handler)
+    return PCA9534_INVALID_PARAM;
+
+  memset(&Handler->Stats, 0, sizeof(Handler->Stats));
+
+  return PCA9534_OK;
 }
+#endif
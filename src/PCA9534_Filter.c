@@ -0,0 +1,231 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Filter.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Input debounce and glitch filter for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_Filter.h"
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the filter
+ * @note   All pins use 1 sample (no filtering) and no majority vote.
+ * @param  Filter: Pointer to filter
+ * @param  State: Initial state of pins
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_Init(PCA9534_Filter_t *Filter, uint8_t State)
+{
+  uint8_t i = 0;
+
+  if (!Filter)
+    return PCA9534_INVALID_PARAM;
+
+  Filter->State = State;
+  for (i = 0; i < 4; i++)
+  {
+    Filter->Count[i] = 0;
+    Filter->Samples[i] = 0;
+  }
+  Filter->Samples[0] = 0xFF;
+  Filter->MajorityMask = 0;
+  Filter->History[0] = State;
+  Filter->History[1] = State;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Set the number of consecutive samples needed to accept a change
+ * @param  Filter: Pointer to filter
+ * @param  Mask: Mask of pins
+ * @param  Samples: Number of samples (1 <= Samples <= PCA9534_FILTER_SAMPLES_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_SetSamples(PCA9534_Filter_t *Filter, uint8_t Mask,
+                          uint8_t Samples)
+{
+  uint8_t i = 0;
+
+  if (!Filter)
+    return PCA9534_INVALID_PARAM;
+
+  if (Samples < 1 || Samples > PCA9534_FILTER_SAMPLES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < 4; i++)
+  {
+    if (Samples & (1 << i))
+      Filter->Samples[i] |= Mask;
+    else
+      Filter->Samples[i] &= ~Mask;
+    Filter->Count[i] &= ~Mask;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Enable majority vote of the last 3 raw samples for pins
+ * @note   The majority vote removes one-sample glitches before debouncing.
+ * @param  Filter: Pointer to filter
+ * @param  Mask: Mask of pins that use majority vote
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_SetMajority(PCA9534_Filter_t *Filter, uint8_t Mask)
+{
+  if (!Filter)
+    return PCA9534_INVALID_PARAM;
+
+  Filter->MajorityMask = Mask;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Feed one raw sample into the filter
+ * @param  Filter: Pointer to filter
+ * @param  Sample: Raw state of pins
+ * @retval Mask of pins whose debounced state changed
+ */
+uint8_t
+PCA9534_Filter_Update(PCA9534_Filter_t *Filter, uint8_t Sample)
+{
+  uint8_t H0 = Filter->History[0];
+  uint8_t H1 = Filter->History[1];
+  uint8_t Majority = (Sample & H0) | (Sample & H1) | (H0 & H1);
+  uint8_t Input = (Sample & ~Filter->MajorityMask) |
+                  (Majority & Filter->MajorityMask);
+  uint8_t Delta = 0;
+  uint8_t Carry = 0;
+  uint8_t Diff = 0;
+  uint8_t Changed = 0;
+  uint8_t Count = 0;
+  uint8_t i = 0;
+
+  Filter->History[1] = H0;
+  Filter->History[0] = Sample;
+
+  // Increment counters of pins that differ from the debounced state and
+  // clear the others
+  Delta = Input ^ Filter->State;
+  Carry = Delta;
+  for (i = 0; i < 4; i++)
+  {
+    Count = Filter->Count[i];
+    Filter->Count[i] = (Count ^ Carry) & Delta;
+    Carry &= Count;
+    Diff |= Filter->Count[i] ^ Filter->Samples[i];
+  }
+
+  // Pins whose counter reached their sample count
+  Changed = Delta & ~Diff;
+  Filter->State ^= Changed;
+  for (i = 0; i < 4; i++)
+    Filter->Count[i] &= ~Changed;
+
+  return Changed;
+}
+
+
+/**
+ * @brief  Feed one raw sample of many devices into their filters
+ * @note   Use it after a sweep that reads many devices into an array.
+ * @param  Filters: Pointer to array of filters
+ * @param  Samples: Pointer to array of raw samples
+ * @param  Changed: Pointer to array of changed masks (can be NULL)
+ * @param  Count: Number of devices
+ * @retval None
+ */
+void
+PCA9534_Filter_UpdateMany(PCA9534_Filter_t *Filters, const uint8_t *Samples,
+                          uint8_t *Changed, uint32_t Count)
+{
+  uint32_t i = 0;
+  uint8_t Mask = 0;
+
+  for (i = 0; i < Count; i++)
+  {
+    Mask = PCA9534_Filter_Update(&Filters[i], Samples[i]);
+    if (Changed)
+      Changed[i] = Mask;
+  }
+}
+
+
+/**
+ * @brief  Read data from the device and filter it
+ * @param  Handler: Pointer to handler
+ * @param  Filter: Pointer to filter
+ * @param  Data: Pointer to debounced data
+ * @param  Changed: Pointer to mask of pins whose debounced state changed
+ *                  (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_Read(PCA9534_Handler_t *Handler, PCA9534_Filter_t *Filter,
+                    uint8_t *Data, uint8_t *Changed)
+{
+  uint8_t Sample = 0;
+  uint8_t Mask = 0;
+
+  if (!Filter || !Data)
+    return PCA9534_INVALID_PARAM;
+
+  if (PCA9534_Read(Handler, &Sample) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  Mask = PCA9534_Filter_Update(Filter, Sample);
+  *Data = Filter->State;
+  if (Changed)
+    *Changed = Mask;
+
+  return PCA9534_OK;
+}
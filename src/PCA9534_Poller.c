@@ -0,0 +1,373 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Poller.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Adaptive input polling for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_Poller.h"
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Budget credit of one poll
+#define PCA9534_POLLER_CREDIT   1000000ull
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####
+ ==================================================================================
+ */
+
+static void
+PCA9534_Poller_Refill(PCA9534_Poller_t *Poller, uint32_t Now)
+{
+  uint64_t Max = (uint64_t)Poller->Count * PCA9534_POLLER_CREDIT;
+
+  Poller->Credit += (uint64_t)(Now - Poller->LastRefill) * Poller->Budget;
+  if (Poller->Credit > Max)
+    Poller->Credit = Max;
+  Poller->LastRefill = Now;
+}
+
+
+static void
+PCA9534_Poller_CountRate(PCA9534_PollerDevice_t *Device, uint32_t Now)
+{
+  uint32_t Elapsed = Now - Device->WindowStart;
+
+  if (Elapsed >= PCA9534_POLLER_RATE_WINDOW)
+  {
+    Device->Rate = (uint32_t)((uint64_t)Device->WindowPolls * 1000000000ull /
+                              Elapsed);
+    Device->WindowStart = Now;
+    Device->WindowPolls = 0;
+  }
+
+  Device->WindowPolls++;
+}
+
+
+static PCA9534_Result_t
+PCA9534_Poller_PollOne(PCA9534_Poller_t *Poller, uint16_t Index, uint32_t Now)
+{
+  PCA9534_PollerDevice_t *Device = &Poller->Devices[Index];
+  uint8_t Data = 0;
+  uint8_t Changed = 0;
+
+  Device->Next = Now + Device->Period;
+  if (PCA9534_Read(Device->Handler, &Data) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  Device->Polls++;
+  PCA9534_Poller_CountRate(Device, Now);
+  Changed = Data ^ Device->Last;
+  Device->Last = Data;
+
+  if (Changed)
+  {
+    Device->Changes++;
+    Device->Period >>= 1;
+    if (Device->Period < Device->MinPeriod)
+      Device->Period = Device->MinPeriod;
+
+    if (Poller->Change)
+      Poller->Change(Index, Data, Changed);
+  }
+  else
+  {
+    Device->Period = (Device->Period > (Device->MaxPeriod >> 1)) ?
+                     Device->MaxPeriod : (Device->Period << 1);
+  }
+  Device->Next = Now + Device->Period;
+
+  return PCA9534_OK;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the poller
+ * @param  Poller: Pointer to poller
+ * @param  Devices: Pointer to array of devices
+ * @param  Count: Number of devices
+ * @param  Budget: Global bus budget in polls per second (0: unlimited)
+ * @param  Change: Function called when an input changes (can be NULL)
+ * @param  Now: Current time in microseconds
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_Init(PCA9534_Poller_t *Poller, PCA9534_PollerDevice_t *Devices,
+                    uint16_t Count, uint32_t Budget,
+                    PCA9534_Poller_Change_t Change, uint32_t Now)
+{
+  uint16_t i = 0;
+
+  if (!Poller || !Devices || !Count)
+    return PCA9534_INVALID_PARAM;
+
+  Poller->Devices = Devices;
+  Poller->Count = Count;
+  Poller->Budget = Budget;
+  Poller->Credit = (uint64_t)Count * PCA9534_POLLER_CREDIT;
+  Poller->LastRefill = Now;
+  Poller->Change = Change;
+
+  for (i = 0; i < Count; i++)
+    Devices[i].Handler = 0;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Set a device of the poller
+ * @note   The device starts at MinPeriod and its last input value at 0, so
+ *         the first poll reports the pins that are high.
+ * @param  Poller: Pointer to poller
+ * @param  Index: Index of device
+ * @param  Handler: Pointer to initialized handler
+ * @param  MinPeriod: Minimum poll period in microseconds (1 <= MinPeriod)
+ * @param  MaxPeriod: Maximum poll period in microseconds
+ *         (MinPeriod <= MaxPeriod <= 0x7FFFFFFF)
+ * @param  Now: Current time in microseconds
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_SetDevice(PCA9534_Poller_t *Poller, uint16_t Index,
+                         PCA9534_Handler_t *Handler, uint32_t MinPeriod,
+                         uint32_t MaxPeriod, uint32_t Now)
+{
+  PCA9534_PollerDevice_t *Device = 0;
+
+  if (!Poller || !Handler || Index >= Poller->Count)
+    return PCA9534_INVALID_PARAM;
+
+  if (!MinPeriod || MinPeriod > MaxPeriod || MaxPeriod > 0x7FFFFFFF)
+    return PCA9534_INVALID_PARAM;
+
+  Device = &Poller->Devices[Index];
+  Device->Handler = Handler;
+  Device->MinPeriod = MinPeriod;
+  Device->MaxPeriod = MaxPeriod;
+  Device->Period = MinPeriod;
+  Device->Next = Now;
+  Device->Last = 0;
+  Device->Polls = 0;
+  Device->Changes = 0;
+  Device->WindowStart = Now;
+  Device->WindowPolls = 0;
+  Device->Rate = 0;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Poll the devices that are due
+ * @note   Due devices are read most overdue first while the bus budget
+ *         allows. A change halves the poll period of the device and a quiet
+ *         poll doubles it, within its bounds.
+ * @param  Poller: Pointer to poller
+ * @param  Now: Current time in microseconds
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read at least one device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_Poll(PCA9534_Poller_t *Poller, uint32_t Now)
+{
+  PCA9534_Result_t Result = PCA9534_OK;
+  PCA9534_PollerDevice_t *Device = 0;
+  int32_t Overdue = 0;
+  int32_t MaxOverdue = 0;
+  int32_t Selected = 0;
+  uint16_t i = 0;
+
+  if (!Poller || !Poller->Devices)
+    return PCA9534_INVALID_PARAM;
+
+  if (Poller->Budget)
+    PCA9534_Poller_Refill(Poller, Now);
+
+  for (;;)
+  {
+    if (Poller->Budget && Poller->Credit < PCA9534_POLLER_CREDIT)
+      break;
+
+    // Most overdue device
+    Selected = -1;
+    MaxOverdue = -1;
+    for (i = 0; i < Poller->Count; i++)
+    {
+      Device = &Poller->Devices[i];
+      if (!Device->Handler)
+        continue;
+
+      Overdue = (int32_t)(Now - Device->Next);
+      if (Overdue > MaxOverdue)
+      {
+        MaxOverdue = Overdue;
+        Selected = i;
+      }
+    }
+
+    if (Selected < 0)
+      break;
+
+    if (Poller->Budget)
+      Poller->Credit -= PCA9534_POLLER_CREDIT;
+
+    if (PCA9534_Poller_PollOne(Poller, (uint16_t)Selected, Now) != PCA9534_OK)
+      Result = PCA9534_FAIL;
+  }
+
+  return Result;
+}
+
+
+/**
+ * @brief  Time until the next device is due
+ * @note   When the bus budget has no credit for a poll, it is the later of
+ *         the next due time and the time the credit is refilled, so a caller
+ *         that sleeps for it does not wake up to a poll that does nothing.
+ * @param  Poller: Pointer to poller
+ * @param  Now: Current time in microseconds
+ * @retval Time in microseconds (0 if a device is already due)
+ */
+uint32_t
+PCA9534_Poller_NextDue(PCA9534_Poller_t *Poller, uint32_t Now)
+{
+  int32_t Wait = 0x7FFFFFFF;
+  int32_t Left = 0;
+  uint64_t Credit = 0;
+  uint64_t Refill = 0;
+  uint16_t i = 0;
+
+  if (!Poller || !Poller->Devices)
+    return 0;
+
+  for (i = 0; i < Poller->Count; i++)
+  {
+    if (!Poller->Devices[i].Handler)
+      continue;
+
+    Left = (int32_t)(Poller->Devices[i].Next - Now);
+    if (Left < Wait)
+      Wait = Left;
+  }
+
+  if (Poller->Budget)
+  {
+    Credit = Poller->Credit +
+             (uint64_t)(Now - Poller->LastRefill) * Poller->Budget;
+    if (Credit < PCA9534_POLLER_CREDIT)
+    {
+      Refill = (PCA9534_POLLER_CREDIT - Credit + Poller->Budget - 1) /
+               Poller->Budget;
+      if ((int64_t)Refill > Wait)
+        Wait = (int32_t)Refill;
+    }
+  }
+
+  return (Wait > 0) ? (uint32_t)Wait : 0;
+}
+
+
+/**
+ * @brief  Target poll rate of a device (1 / current poll period)
+ * @note   The bus budget may keep the measured rate below it; see
+ *         PCA9534_Poller_GetRate.
+ * @param  Poller: Pointer to poller
+ * @param  Index: Index of device
+ * @param  MilliHz: Pointer to poll rate in mHz
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_GetTargetRate(PCA9534_Poller_t *Poller, uint16_t Index,
+                             uint32_t *MilliHz)
+{
+  if (!Poller || !MilliHz || Index >= Poller->Count ||
+      !Poller->Devices[Index].Handler)
+    return PCA9534_INVALID_PARAM;
+
+  *MilliHz = (uint32_t)(1000000000ull / Poller->Devices[Index].Period);
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Measured poll rate of a device
+ * @note   Completed polls are counted over windows of
+ *         PCA9534_POLLER_RATE_WINDOW, so the rate shows the throttling of
+ *         the bus budget. It is the rate of the last complete window, or of
+ *         the current one if it is already longer than a window (a starved
+ *         device) or no window is complete yet.
+ * @param  Poller: Pointer to poller
+ * @param  Index: Index of device
+ * @param  Now: Current time in microseconds
+ * @param  MilliHz: Pointer to poll rate in mHz
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_GetRate(PCA9534_Poller_t *Poller, uint16_t Index, uint32_t Now,
+                       uint32_t *MilliHz)
+{
+  PCA9534_PollerDevice_t *Device = 0;
+  uint32_t Elapsed = 0;
+
+  if (!Poller || !MilliHz || Index >= Poller->Count ||
+      !Poller->Devices[Index].Handler)
+    return PCA9534_INVALID_PARAM;
+
+  Device = &Poller->Devices[Index];
+  Elapsed = Now - Device->WindowStart;
+  if (Elapsed >= PCA9534_POLLER_RATE_WINDOW || (!Device->Rate && Elapsed))
+    *MilliHz = (uint32_t)((uint64_t)Device->WindowPolls * 1000000000ull /
+                          Elapsed);
+  else
+    *MilliHz = Device->Rate;
+
+  return PCA9534_OK;
+}
@@ -0,0 +1,308 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Scan.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Bus scan and device type detection for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_Scan.h"
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Address windows
+#define PCA9534_SCAN_WINDOW         0x20
+#define PCA9534_SCAN_WINDOW_A       0x38
+
+// Probed registers
+#define PCA9534_SCAN_REG_INPUT      0x00
+#define PCA9534_SCAN_REG_PORT_1     0x04
+#define PCA9534_SCAN_REG_AGILE      0x40
+
+// Register window compare results
+#define PCA9534_SCAN_ABSENT         0
+#define PCA9534_SCAN_OWN            1
+#define PCA9534_SCAN_ALIASED        2
+#define PCA9534_SCAN_ERROR          3
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####
+ ==================================================================================
+ */
+
+static uint8_t
+PCA9534_Scan_Ack(const PCA9534_Platform_t *Platform, uint8_t AddressI2C,
+                 uint8_t Register)
+{
+  return (Platform->Send(AddressI2C, &Register, 1) >= 0);
+}
+
+static uint8_t
+PCA9534_Scan_Read(const PCA9534_Platform_t *Platform, uint8_t AddressI2C,
+                  uint8_t Register, uint8_t *Data)
+{
+  if (!PCA9534_Scan_Ack(Platform, AddressI2C, Register))
+    return PCA9534_SCAN_ABSENT;
+
+  if (Platform->Receive(AddressI2C, Data, 1) < 0)
+    return PCA9534_SCAN_ERROR;
+
+  return PCA9534_SCAN_OWN;
+}
+
+/*
+ * Parts without a register often ignore the upper bits of the command byte
+ * and acknowledge it, so an ACK alone does not prove the register exists.
+ * The static registers of the basic set (Output, Polarity and Configuration)
+ * are compared with the same offsets from Base: an aliasing part reads the
+ * same bytes twice, while a part with its own registers there differs in at
+ * least one of them.
+ * Equal contents can not tell the two apart, so they are reported as aliased.
+ */
+static uint8_t
+PCA9534_Scan_Compare(const PCA9534_Platform_t *Platform, uint8_t AddressI2C,
+                     uint8_t Base, uint8_t Ports)
+{
+  uint8_t Data = 0;
+  uint8_t Other = 0;
+  uint8_t Result = 0;
+  uint8_t Offset = 0;
+
+  for (Offset = Ports; Offset < 4 * Ports; Offset++)
+  {
+    Result = PCA9534_Scan_Read(Platform, AddressI2C, Base + Offset, &Other);
+    if (Result != PCA9534_SCAN_OWN)
+      return Result;
+
+    if (PCA9534_Scan_Read(Platform, AddressI2C, Offset, &Data) !=
+        PCA9534_SCAN_OWN)
+      return PCA9534_SCAN_ERROR;
+
+    if (Data != Other)
+      return PCA9534_SCAN_OWN;
+  }
+
+  return PCA9534_SCAN_ALIASED;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Detect the type of a device
+ * @note   Only register pointers are written and no register is changed. The
+ *         parts are told apart by the registers they have: a command byte
+ *         that is not acknowledged means the register is missing, and one
+ *         that is acknowledged is confirmed by reading the registers back
+ *         (parts that alias the command byte return the same contents as the
+ *         basic registers). Drop-in compatible parts can not be told apart,
+ *         so the result is the first part of the family: PCA9534, PCA9534A,
+ *         PCA9535, PCAL9534 or PCAL9535.
+ * @note   If the read back can not decide (the compared registers hold the
+ *         same values), the smaller part is reported and Ambiguous is set.
+ *         A part that aliases the command bytes always ends here, since it
+ *         can not be told from a larger part whose extra registers hold the
+ *         same values. The type must then be given by the application.
+ * @param  Platform: Pointer to platform dependent layer (bus initialized)
+ * @param  AddressI2C: I2C Address
+ * @param  Device: Pointer to device type
+ * @param  Ambiguous: Pointer to ambiguous flag (can be NULL)
+ *         - 0: Device type is confirmed.
+ *         - 1: Device type could not be confirmed.
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: No device answers or failed to read back.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Detect(const PCA9534_Platform_t *Platform, uint8_t AddressI2C,
+               PCA9534_Device_t *Device, uint8_t *Ambiguous)
+{
+  uint8_t Data = 0;
+  uint8_t Ports = 1;
+  uint8_t Agile = 0;
+  uint8_t Result = 0;
+
+  if (!Platform || !Platform->Send || !Platform->Receive || !Device)
+    return PCA9534_INVALID_PARAM;
+
+  if (Ambiguous)
+    *Ambiguous = 0;
+
+  if (!PCA9534_Scan_Ack(Platform, AddressI2C, PCA9534_SCAN_REG_INPUT))
+    return PCA9534_FAIL;
+
+  // Complete a read, so the part is known to answer as an expander
+  if (Platform->Receive(AddressI2C, &Data, 1) < 0)
+    return PCA9534_FAIL;
+
+  if ((AddressI2C & 0xF8) == PCA9534_SCAN_WINDOW_A)
+  {
+    *Device = PCA9534_DEVICE_PCA9534A;
+    return PCA9534_OK;
+  }
+
+  Result = PCA9534_Scan_Compare(Platform, AddressI2C,
+                                PCA9534_SCAN_REG_PORT_1, 1);
+  if (Result == PCA9534_SCAN_ERROR)
+    return PCA9534_FAIL;
+  if (Result == PCA9534_SCAN_OWN)
+    Ports = 2;
+  if (Result == PCA9534_SCAN_ALIASED && Ambiguous)
+    *Ambiguous = 1;
+
+  Result = PCA9534_Scan_Compare(Platform, AddressI2C,
+                                PCA9534_SCAN_REG_AGILE, Ports);
+  if (Result == PCA9534_SCAN_ERROR)
+    return PCA9534_FAIL;
+  if (Result == PCA9534_SCAN_OWN)
+    Agile = 1;
+  if (Result == PCA9534_SCAN_ALIASED && Ambiguous)
+    *Ambiguous = 1;
+
+  if (Agile)
+    *Device = (Ports == 2) ? PCA9534_DEVICE_PCAL9535 : PCA9534_DEVICE_PCAL9534;
+  else
+    *Device = (Ports == 2) ? PCA9534_DEVICE_PCA9535 : PCA9534_DEVICE_PCA9534;
+
+  // Leave the pointer at the Input Port register
+  PCA9534_Scan_Ack(Platform, AddressI2C, PCA9534_SCAN_REG_INPUT);
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Scan a bus for devices
+ * @note   The address windows 0x20-0x27 and 0x38-0x3F are probed on every
+ *         multiplexer channel. The scan keeps no state, so the buses of a
+ *         system can be scanned in parallel (one task per bus).
+ * @note   If Handlers is not NULL, each found device gets a handler with a
+ *         copy of Platform without Init, since the bus is already
+ *         initialized. Devices with an ambiguous type get no handler
+ *         (its Part is NULL). By default the handler is filled by reading the
+ *         registers back (PCA9534_InitFromDevice), so a device that is already
+ *         driving its pins is left untouched. With Reset the device is
+ *         initialized with PCA9534_Init instead, which writes the power-on
+ *         defaults. With a multiplexer the application must select Channel
+ *         before using it.
+ * @param  Platform: Pointer to platform dependent layer (bus initialized)
+ * @param  Select: Function to select a multiplexer channel (can be NULL)
+ * @param  Channels: Number of multiplexer channels (ignored if Select is NULL)
+ * @param  Results: Pointer to array of found devices
+ * @param  Handlers: Pointer to array of handlers (can be NULL)
+ * @param  Reset: Write the power-on defaults to found devices (ignored if
+ *                Handlers is NULL)
+ *         - 0: Read the registers back, no register is changed.
+ *         - 1: Reset the registers with PCA9534_Init.
+ * @param  Max: Number of elements of Results and Handlers
+ * @param  Count: Pointer to number of found devices
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to select a channel or to initialize a
+ *                         handler, or more than Max devices were found.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Scan(const PCA9534_Platform_t *Platform, PCA9534_Scan_Select_t Select,
+             uint8_t Channels, PCA9534_ScanResult_t *Results,
+             PCA9534_Handler_t *Handlers, uint8_t Reset, uint8_t Max,
+             uint8_t *Count)
+{
+  const PCA9534_Part_t *Part = 0;
+  PCA9534_Result_t Result = PCA9534_OK;
+  PCA9534_Device_t Device = PCA9534_DEVICE_PCA9534;
+  uint8_t Ambiguous = 0;
+  uint8_t Channel = 0;
+  uint8_t Window = 0;
+  uint8_t Pins = 0;
+  uint8_t Found = 0;
+  uint8_t Address = 0;
+
+  if (!Platform || !Results || !Count)
+    return PCA9534_INVALID_PARAM;
+
+  *Count = 0;
+  if (!Select)
+    Channels = 1;
+
+  for (Channel = 0; Channel < Channels; Channel++)
+  {
+    if (Select && Select(Channel) < 0)
+      return PCA9534_FAIL;
+
+    for (Window = 0; Window < 2; Window++)
+    {
+      for (Pins = 0; Pins < 8; Pins++)
+      {
+        Address = (Window ? PCA9534_SCAN_WINDOW_A : PCA9534_SCAN_WINDOW) | Pins;
+        if (PCA9534_Detect(Platform, Address, &Device,
+                           &Ambiguous) != PCA9534_OK)
+          continue;
+
+        if (Found == Max)
+          return PCA9534_FAIL;
+
+        Results[Found].Channel = Channel;
+        Results[Found].AddressI2C = Address;
+        Results[Found].Device = Device;
+        Results[Found].Ambiguous = Ambiguous;
+
+        if (Handlers && Ambiguous)
+        {
+          Handlers[Found].Part = 0;
+        }
+        else if (Handlers)
+        {
+          Part = PCA9534_GetPart(Device);
+          Handlers[Found].Platform = *Platform;
+          Handlers[Found].Platform.Init = 0;
+          if (Reset)
+            Result = PCA9534_Init(&Handlers[Found], Device,
+                                  Address - Part->AddressBase);
+          else
+            Result = PCA9534_InitFromDevice(&Handlers[Found], Device,
+                                            Address - Part->AddressBase);
+          if (Result != PCA9534_OK)
+            return PCA9534_FAIL;
+        }
+
+        Found++;
+        *Count = Found;
+      }
+    }
+  }
+
+  return PCA9534_OK;
+}
@@ -0,0 +1,167 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_SharedInt.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Shared interrupt line dispatcher for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_SharedInt.h"
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####
+ ==================================================================================
+ */
+
+static void
+PCA9534_SharedInt_MoveToFront(PCA9534_SharedInt_t *Group, uint8_t Position)
+{
+  uint8_t Index = Group->Order[Position];
+
+  for (; Position; Position--)
+    Group->Order[Position] = Group->Order[Position - 1];
+  Group->Order[0] = Index;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a shared interrupt group
+ * @note   All devices are read once to get their input values and to clear
+ *         pending interrupts.
+ * @param  Group: Pointer to group
+ * @param  Handlers: Pointer to array of initialized handlers
+ * @param  Count: Number of devices (1 <= Count <= PCA9534_SHAREDINT_DEVICES_MAX)
+ * @param  Level: Function to read the level of the interrupt line
+ * @param  Change: Function called when an input changes (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read a device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SharedInt_Init(PCA9534_SharedInt_t *Group, PCA9534_Handler_t **Handlers,
+                       uint8_t Count, PCA9534_SharedInt_Level_t Level,
+                       PCA9534_SharedInt_Change_t Change)
+{
+  uint8_t i = 0;
+
+  if (!Group || !Handlers || !Level)
+    return PCA9534_INVALID_PARAM;
+
+  if (!Count || Count > PCA9534_SHAREDINT_DEVICES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  Group->Handlers = Handlers;
+  Group->Count = Count;
+  Group->Level = Level;
+  Group->Change = Change;
+  Group->Interrupts = 0;
+  Group->Reads = 0;
+
+  for (i = 0; i < Count; i++)
+  {
+    Group->Order[i] = i;
+    if (PCA9534_Read(Handlers[i], &Group->Last[i]) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Handle an interrupt of the shared line
+ * @note   Call it from task context after the line was asserted.
+ * @param  Group: Pointer to group
+ * @param  Reads: Pointer to number of devices read (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read a device or the line stays asserted.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SharedInt_Handle(PCA9534_SharedInt_t *Group, uint8_t *Reads)
+{
+  PCA9534_Result_t Result = PCA9534_OK;
+  uint8_t Count = 0;
+  uint8_t Pass = 0;
+  uint8_t Position = 0;
+  uint8_t Index = 0;
+  uint8_t Data = 0;
+  uint8_t Changed = 0;
+  uint8_t Asserted = 1;
+
+  if (!Group || !Group->Handlers || !Group->Level)
+    return PCA9534_INVALID_PARAM;
+
+  Group->Interrupts++;
+
+  for (Pass = 0; Asserted && Pass < PCA9534_SHAREDINT_PASSES_MAX; Pass++)
+  {
+    for (Position = 0; Position < Group->Count; Position++)
+    {
+      Asserted = Group->Level();
+      if (!Asserted)
+        break;
+
+      Index = Group->Order[Position];
+      Count++;
+      if (PCA9534_Read(Group->Handlers[Index], &Data) != PCA9534_OK)
+      {
+        Result = PCA9534_FAIL;
+        continue;
+      }
+
+      Changed = Data ^ Group->Last[Index];
+      if (!Changed)
+        continue;
+
+      Group->Last[Index] = Data;
+      PCA9534_SharedInt_MoveToFront(Group, Position);
+      if (Group->Change)
+        Group->Change(Index, Data, Changed);
+    }
+  }
+
+  if (Asserted && Group->Level())
+    Result = PCA9534_FAIL;
+
+  Group->Reads += Count;
+  if (Reads)
+    *Reads = Count;
+
+  return Result;
+}
@@ -0,0 +1,341 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Subscribe.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Per-pin change subscription for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_Subscribe.h"
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####
+ ==================================================================================
+ */
+
+static uint8_t
+Subscribe_Ctz(uint8_t x)
+{
+#if defined(__GNUC__)
+  return (uint8_t)__builtin_ctz(x);
+#else
+  uint8_t n = 0;
+  while (!(x & 0x01))
+  {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the subscription table
+ * @note   The last input value of all devices starts at 0.
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Devices: Pointer to array of devices
+ * @param  DeviceCount: Number of devices
+ * @param  Table: Pointer to array of subscriptions
+ * @param  TableSize: Number of subscriptions (TableSize < PCA9534_SUBSCRIBE_NONE)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Init(PCA9534_Subscribe_t *Subscribe,
+                       PCA9534_SubscribeDevice_t *Devices, uint8_t DeviceCount,
+                       PCA9534_Subscription_t *Table, uint16_t TableSize)
+{
+  uint16_t i = 0;
+  uint8_t Pin = 0;
+
+  if (!Subscribe || !Devices || !Table || TableSize >= PCA9534_SUBSCRIBE_NONE)
+    return PCA9534_INVALID_PARAM;
+
+  Subscribe->Devices = Devices;
+  Subscribe->DeviceCount = DeviceCount;
+  Subscribe->Table = Table;
+  Subscribe->TableSize = TableSize;
+
+  for (i = 0; i < DeviceCount; i++)
+  {
+    for (Pin = 0; Pin < 8; Pin++)
+      Devices[i].Head[Pin] = PCA9534_SUBSCRIBE_NONE;
+    Devices[i].RisingMask = 0;
+    Devices[i].FallingMask = 0;
+    Devices[i].Last = 0;
+  }
+
+  for (i = 0; i < TableSize; i++)
+  {
+    Table[i].Callback = 0;
+    Table[i].Next = i + 1;
+  }
+  if (TableSize)
+    Table[TableSize - 1].Next = PCA9534_SUBSCRIBE_NONE;
+  Subscribe->Free = TableSize ? 0 : PCA9534_SUBSCRIBE_NONE;
+  Subscribe->Cursor = PCA9534_SUBSCRIBE_NONE;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Add a subscription
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Pin: Pin number (0 <= Pin <= 7)
+ * @param  Edge: Edge to be notified about
+ * @param  Callback: Function called on the edge
+ * @param  Context: Context passed to Callback
+ * @param  Id: Pointer to ID of subscription (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: The table is full.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Add(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                      uint8_t Pin, PCA9534_Edge_t Edge,
+                      PCA9534_Subscribe_Callback_t Callback, void *Context,
+                      uint16_t *Id)
+{
+  PCA9534_SubscribeDevice_t *Dev = 0;
+  PCA9534_Subscription_t *Sub = 0;
+  uint16_t Index = 0;
+
+  if (!Subscribe || !Subscribe->Table || !Callback)
+    return PCA9534_INVALID_PARAM;
+
+  if (Device >= Subscribe->DeviceCount || Pin > 7 ||
+      !(Edge & PCA9534_EDGE_BOTH))
+    return PCA9534_INVALID_PARAM;
+
+  Index = Subscribe->Free;
+  if (Index == PCA9534_SUBSCRIBE_NONE)
+    return PCA9534_FAIL;
+
+  Sub = &Subscribe->Table[Index];
+  Subscribe->Free = Sub->Next;
+
+  Dev = &Subscribe->Devices[Device];
+  Sub->Callback = Callback;
+  Sub->Context = Context;
+  Sub->Device = Device;
+  Sub->Pin = Pin;
+  Sub->Edge = (uint8_t)Edge;
+  Sub->Next = Dev->Head[Pin];
+  Dev->Head[Pin] = Index;
+
+  if (Edge & PCA9534_EDGE_RISING)
+    Dev->RisingMask |= (1 << Pin);
+  if (Edge & PCA9534_EDGE_FALLING)
+    Dev->FallingMask |= (1 << Pin);
+
+  if (Id)
+    *Id = Index;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Remove a subscription
+ * @note   It can be called from a callback during a dispatch.
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Id: ID of subscription
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Remove(PCA9534_Subscribe_t *Subscribe, uint16_t Id)
+{
+  PCA9534_SubscribeDevice_t *Dev = 0;
+  PCA9534_Subscription_t *Sub = 0;
+  uint16_t *Link = 0;
+  uint8_t Edges = 0;
+  uint8_t Pin = 0;
+
+  if (!Subscribe || !Subscribe->Table || Id >= Subscribe->TableSize)
+    return PCA9534_INVALID_PARAM;
+
+  Sub = &Subscribe->Table[Id];
+  if (!Sub->Callback)
+    return PCA9534_INVALID_PARAM;
+
+  Pin = Sub->Pin;
+  Dev = &Subscribe->Devices[Sub->Device];
+
+  // Unlink it and collect the edges of the remaining subscribers of the pin
+  Link = &Dev->Head[Pin];
+  while (*Link != PCA9534_SUBSCRIBE_NONE)
+  {
+    if (*Link == Id)
+    {
+      *Link = Sub->Next;
+      continue;
+    }
+    Edges |= Subscribe->Table[*Link].Edge;
+    Link = &Subscribe->Table[*Link].Next;
+  }
+
+  Dev->RisingMask &= ~(1 << Pin);
+  Dev->FallingMask &= ~(1 << Pin);
+  if (Edges & PCA9534_EDGE_RISING)
+    Dev->RisingMask |= (1 << Pin);
+  if (Edges & PCA9534_EDGE_FALLING)
+    Dev->FallingMask |= (1 << Pin);
+
+  // Step a running dispatch over it before it goes to the free list
+  if (Subscribe->Cursor == Id)
+    Subscribe->Cursor = Sub->Next;
+
+  Sub->Callback = 0;
+  Sub->Next = Subscribe->Free;
+  Subscribe->Free = Id;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Set the last input value of a device without notification
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Data: Input value
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_SetLast(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                          uint8_t Data)
+{
+  if (!Subscribe || !Subscribe->Devices || Device >= Subscribe->DeviceCount)
+    return PCA9534_INVALID_PARAM;
+
+  Subscribe->Devices[Device].Last = Data;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Notify the subscribers of the pins changed by a new sample
+ * @note   The changed mask is computed once and only its set bits with
+ *         subscribers for the edge are visited.
+ * @note   A callback may add subscriptions and remove any subscription,
+ *         including its own. A subscription added by a callback is notified
+ *         of this change only if its pin has not been visited yet. Dispatch
+ *         and Read must not be called from a callback.
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Data: New input value
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Dispatch(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                           uint8_t Data)
+{
+  PCA9534_SubscribeDevice_t *Dev = 0;
+  PCA9534_Subscription_t *Sub = 0;
+  uint8_t Changed = 0;
+  uint8_t Active = 0;
+  uint8_t Pin = 0;
+  uint8_t Level = 0;
+  uint8_t Edge = 0;
+
+  if (!Subscribe || !Subscribe->Devices || Device >= Subscribe->DeviceCount)
+    return PCA9534_INVALID_PARAM;
+
+  Dev = &Subscribe->Devices[Device];
+  Changed = Data ^ Dev->Last;
+  Dev->Last = Data;
+
+  Active = (Changed & Data & Dev->RisingMask) |
+           (Changed & ~Data & Dev->FallingMask);
+
+  while (Active)
+  {
+    Pin = Subscribe_Ctz(Active);
+    Active &= Active - 1;
+
+    Level = (Data >> Pin) & 0x01;
+    Edge = Level ? PCA9534_EDGE_RISING : PCA9534_EDGE_FALLING;
+
+    // The cursor is taken before the callback, which may remove subscriptions
+    Subscribe->Cursor = Dev->Head[Pin];
+    while (Subscribe->Cursor != PCA9534_SUBSCRIBE_NONE)
+    {
+      Sub = &Subscribe->Table[Subscribe->Cursor];
+      Subscribe->Cursor = Sub->Next;
+      if (Sub->Edge & Edge)
+        Sub->Callback(Device, Pin, Level, Sub->Context);
+    }
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Read the input port of a device and notify the subscribers
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Handler: Pointer to handler of device
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read the device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Read(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                       PCA9534_Handler_t *Handler)
+{
+  uint8_t Data = 0;
+
+  if (!Subscribe || !Handler)
+    return PCA9534_INVALID_PARAM;
+
+  if (PCA9534_Read(Handler, &Data) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  return PCA9534_Subscribe_Dispatch(Subscribe, Device, Data);
+}
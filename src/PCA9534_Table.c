@@ -0,0 +1,459 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Table.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Struct-of-arrays device table for large PCA9534 installations
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_Table.h"
+#include <string.h>
+#if PCA9534_TABLE_SIMD && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  Register addresses
+ */
+#define PCA9534_TABLE_REG_INPUT_PORT      0x00
+#define PCA9534_TABLE_REG_OUTPUT_PORT     0x01
+#define PCA9534_TABLE_REG_POLARITY_INVERT 0x02
+#define PCA9534_TABLE_REG_CONFIGURATION   0x03
+
+/**
+ * @brief  Power-on default values of registers
+ */
+#define PCA9534_TABLE_DEFAULT_OUTPUT_PORT     0xFF
+#define PCA9534_TABLE_DEFAULT_POLARITY_INVERT 0x00
+#define PCA9534_TABLE_DEFAULT_CONFIGURATION   0xFF
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####
+ ==================================================================================
+ */
+
+static uint8_t
+Table_Ctz(uint32_t x)
+{
+#if defined(__GNUC__)
+  return (uint8_t)__builtin_ctz(x);
+#else
+  uint8_t n = 0;
+  while (!(x & 0x01))
+  {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+
+/**
+ * @brief  Change mask of 32 devices: bit n is set if device n changed
+ */
+static uint32_t
+Table_ChangeMask32(const uint8_t *Input, const uint8_t *Previous)
+{
+#if PCA9534_TABLE_SIMD && defined(__AVX2__)
+  __m256i a = _mm256_loadu_si256((const __m256i *)Input);
+  __m256i b = _mm256_loadu_si256((const __m256i *)Previous);
+
+  return ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+#elif PCA9534_TABLE_SIMD && defined(__SSE2__)
+  __m128i a0 = _mm_loadu_si128((const __m128i *)Input);
+  __m128i b0 = _mm_loadu_si128((const __m128i *)Previous);
+  __m128i a1 = _mm_loadu_si128((const __m128i *)(Input + 16));
+  __m128i b1 = _mm_loadu_si128((const __m128i *)(Previous + 16));
+  uint32_t Equal = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a0, b0)) |
+                   ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a1, b1)) << 16);
+
+  return ~Equal;
+#else
+  uint32_t Mask = 0;
+  uint8_t i = 0;
+
+  for (i = 0; i < 32; i++)
+    Mask |= (uint32_t)(Input[i] != Previous[i]) << i;
+
+  return Mask;
+#endif
+}
+
+
+static PCA9534_Result_t
+PCA9534_Table_WriteReg(PCA9534_Table_t *Table, uint16_t Id, uint8_t Address,
+                       uint8_t Data)
+{
+  const PCA9534_Platform_t *Platform = &Table->Buses[Table->Bus[Id]];
+  uint8_t Buffer[2] = {Address, Data};
+
+  if (Platform->Send(Table->AddressI2C[Id], Buffer, 2) < 0)
+    return PCA9534_FAIL;
+
+  return PCA9534_OK;
+}
+
+
+static PCA9534_Result_t
+PCA9534_Table_ReadReg(PCA9534_Table_t *Table, uint16_t Id, uint8_t Address,
+                      uint8_t *Data)
+{
+  const PCA9534_Platform_t *Platform = &Table->Buses[Table->Bus[Id]];
+
+  if (Platform->Send(Table->AddressI2C[Id], &Address, 1) < 0)
+    return PCA9534_FAIL;
+
+  if (Platform->Receive(Table->AddressI2C[Id], Data, 1) < 0)
+    return PCA9534_FAIL;
+
+  return PCA9534_OK;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a device table
+ * @param  Table: Pointer to table
+ * @param  Buses: Pointer to array of platform dependent layers (buses
+ *                initialized, Send and Receive linked)
+ * @param  BusCount: Number of buses
+ * @param  Storage: Pointer to 4-byte aligned storage of
+ *                  PCA9534_TABLE_STORAGE(Capacity) bytes
+ * @param  Capacity: Maximum number of devices
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Init(PCA9534_Table_t *Table, const PCA9534_Platform_t *Buses,
+                   uint8_t BusCount, void *Storage, uint16_t Capacity)
+{
+  uint8_t *Bytes = (uint8_t *)Storage;
+  uint32_t Padded = 0;
+
+  if (!Table || !Buses || !BusCount || !Storage || !Capacity)
+    return PCA9534_INVALID_PARAM;
+
+  Padded = PCA9534_TABLE_PADDED((uint32_t)Capacity);
+
+  Table->Buses = Buses;
+  Table->BusCount = BusCount;
+  Table->Capacity = Capacity;
+  Table->Count = 0;
+
+  Table->Time = (uint32_t *)Storage;
+  Bytes += Padded * sizeof(uint32_t);
+  Table->AddressI2C = Bytes;
+  Table->Bus = Bytes + Padded;
+  Table->Output = Bytes + Padded * 2;
+  Table->Polarity = Bytes + Padded * 3;
+  Table->Config = Bytes + Padded * 4;
+  Table->Input = Bytes + Padded * 5;
+  Table->Previous = Bytes + Padded * 6;
+  Table->Health = Bytes + Padded * 7;
+
+  memset(Storage, 0, PCA9534_TABLE_STORAGE((uint32_t)Capacity));
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Add a device to the table
+ * @note   Nothing is sent to the device. Its shadows start at the power-on
+ *         defaults.
+ * @param  Table: Pointer to table
+ * @param  Bus: Bus ID
+ * @param  AddressI2C: I2C Address
+ * @param  Id: Pointer to device ID (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: The table is full.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Add(PCA9534_Table_t *Table, uint8_t Bus, uint8_t AddressI2C,
+                  uint16_t *Id)
+{
+  uint16_t i = 0;
+
+  if (!Table || Bus >= Table->BusCount || AddressI2C > 127)
+    return PCA9534_INVALID_PARAM;
+
+  if (Table->Count == Table->Capacity)
+    return PCA9534_FAIL;
+
+  i = Table->Count++;
+  Table->AddressI2C[i] = AddressI2C;
+  Table->Bus[i] = Bus;
+  Table->Output[i] = PCA9534_TABLE_DEFAULT_OUTPUT_PORT;
+  Table->Polarity[i] = PCA9534_TABLE_DEFAULT_POLARITY_INVERT;
+  Table->Config[i] = PCA9534_TABLE_DEFAULT_CONFIGURATION;
+  Table->Input[i] = 0;
+  Table->Previous[i] = 0;
+  Table->Health[i] = 0;
+  Table->Time[i] = 0;
+
+  if (Id)
+    *Id = i;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Set direction of pins of a device
+ * @param  Table: Pointer to table
+ * @param  Id: Device ID
+ * @param  Dir: Direction of pins (1: Output, 0: Input)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_SetDir(PCA9534_Table_t *Table, uint16_t Id, uint8_t Dir)
+{
+  if (!Table || Id >= Table->Count)
+    return PCA9534_INVALID_PARAM;
+
+  Dir = ~Dir;
+  if (PCA9534_Table_WriteReg(Table, Id, PCA9534_TABLE_REG_CONFIGURATION,
+                             Dir) != PCA9534_OK)
+    return PCA9534_FAIL;
+  Table->Config[Id] = Dir;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Write data to a device
+ * @param  Table: Pointer to table
+ * @param  Id: Device ID
+ * @param  Data: Data to write
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Write(PCA9534_Table_t *Table, uint16_t Id, uint8_t Data)
+{
+  if (!Table || Id >= Table->Count)
+    return PCA9534_INVALID_PARAM;
+
+  if (PCA9534_Table_WriteReg(Table, Id, PCA9534_TABLE_REG_OUTPUT_PORT,
+                             Data) != PCA9534_OK)
+    return PCA9534_FAIL;
+  Table->Output[Id] = Data;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Read the inputs of a range of devices
+ * @note   The current inputs are moved to Previous first. A failed device
+ *         keeps its input and its Health is incremented.
+ * @param  Table: Pointer to table
+ * @param  First: ID of first device
+ * @param  Count: Number of devices
+ * @param  Now: Current time
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read at least one device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Sweep(PCA9534_Table_t *Table, uint16_t First, uint16_t Count,
+                    uint32_t Now)
+{
+  PCA9534_Result_t Result = PCA9534_OK;
+  uint8_t *Input = 0;
+  uint8_t *Health = 0;
+  uint32_t End = 0;
+  uint32_t i = 0;
+
+  if (!Table || (uint32_t)First + Count > Table->Count)
+    return PCA9534_INVALID_PARAM;
+
+  End = (uint32_t)First + Count;
+  Input = Table->Input;
+  Health = Table->Health;
+
+  memcpy(&Table->Previous[First], &Input[First], Count);
+
+  for (i = First; i < End; i++)
+  {
+    if (PCA9534_Table_ReadReg(Table, (uint16_t)i, PCA9534_TABLE_REG_INPUT_PORT,
+                              &Input[i]) != PCA9534_OK)
+    {
+      if (Health[i] < PCA9534_TABLE_HEALTH_MAX)
+        Health[i]++;
+      Result = PCA9534_FAIL;
+      continue;
+    }
+
+    Health[i] = 0;
+    Table->Time[i] = Now;
+  }
+
+  return Result;
+}
+
+
+/**
+ * @brief  Find the devices of a range whose inputs changed in the last sweep
+ * @note   Use the same range as the sweep: Previous is only updated for the
+ *         swept devices, so the changes of other devices would be reported
+ *         again.
+ * @param  Table: Pointer to table
+ * @param  First: ID of first device
+ * @param  Count: Number of devices
+ * @param  Ids: Pointer to array of changed device IDs (Count elements)
+ * @param  Masks: Pointer to array of changed pins (Count elements)
+ * @param  Changed: Pointer to number of changed devices
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Diff(PCA9534_Table_t *Table, uint16_t First, uint16_t Count,
+                   uint16_t *Ids, uint8_t *Masks, uint16_t *Changed)
+{
+  const uint8_t *Input = 0;
+  const uint8_t *Previous = 0;
+  uint32_t Bits = 0;
+  uint32_t Base = 0;
+  uint32_t End = 0;
+  uint16_t Found = 0;
+  uint16_t i = 0;
+
+  if (!Table || !Ids || !Masks || !Changed ||
+      (uint32_t)First + Count > Table->Count)
+    return PCA9534_INVALID_PARAM;
+
+  End = (uint32_t)First + Count;
+  Input = Table->Input;
+  Previous = Table->Previous;
+
+  // The arrays are padded to PCA9534_TABLE_ALIGN, so whole aligned blocks are
+  // loaded and the devices out of the range are masked off
+  Base = First - First % PCA9534_TABLE_ALIGN;
+  for (; Base < End; Base += 32)
+  {
+    Bits = Table_ChangeMask32(&Input[Base], &Previous[Base]);
+    if (Base < First)
+      Bits &= ~((1UL << (First - Base)) - 1);
+    if (End - Base < 32)
+      Bits &= (1UL << (End - Base)) - 1;
+
+    for (; Bits; Bits &= Bits - 1)
+    {
+      i = (uint16_t)(Base + Table_Ctz(Bits));
+      Ids[Found] = i;
+      Masks[Found] = Input[i] ^ Previous[i];
+      Found++;
+    }
+  }
+
+  *Changed = Found;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Check a range of devices for reset and restore them
+ * @note   The Configuration register of each device is read back. On
+ *         mismatch Output, Polarity Inversion and Configuration are
+ *         rewritten from the shadows.
+ * @param  Table: Pointer to table
+ * @param  First: ID of first device
+ * @param  Count: Number of devices
+ * @param  Restored: Pointer to number of restored devices (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Scrub(PCA9534_Table_t *Table, uint16_t First, uint16_t Count,
+                    uint16_t *Restored)
+{
+  uint16_t Done = 0;
+  uint32_t End = 0;
+  uint32_t i = 0;
+  uint8_t Reg = 0;
+
+  if (!Table || (uint32_t)First + Count > Table->Count)
+    return PCA9534_INVALID_PARAM;
+
+  if (Restored)
+    *Restored = 0;
+
+  End = (uint32_t)First + Count;
+  for (i = First; i < End; i++)
+  {
+    if (PCA9534_Table_ReadReg(Table, (uint16_t)i,
+                              PCA9534_TABLE_REG_CONFIGURATION,
+                              &Reg) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    if (Reg == Table->Config[i])
+      continue;
+
+    // Output first, so the outputs are driven with the right level when enabled
+    if (PCA9534_Table_WriteReg(Table, (uint16_t)i, PCA9534_TABLE_REG_OUTPUT_PORT,
+                               Table->Output[i]) != PCA9534_OK ||
+        PCA9534_Table_WriteReg(Table, (uint16_t)i,
+                               PCA9534_TABLE_REG_POLARITY_INVERT,
+                               Table->Polarity[i]) != PCA9534_OK ||
+        PCA9534_Table_WriteReg(Table, (uint16_t)i,
+                               PCA9534_TABLE_REG_CONFIGURATION,
+                               Table->Config[i]) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    Done++;
+    if (Restored)
+      *Restored = Done;
+  }
+
+  return PCA9534_OK;
+}
@@ -0,0 +1,212 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Transaction.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Atomic multi-device output commit for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_Transaction.h"
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a transaction object
+ * @param  Transaction: Pointer to transaction
+ * @param  Handlers: Pointer to array of pointers to initialized handlers (in
+ *                   order of writing)
+ * @param  Count: Number of devices
+ *         (1 <= Count <= PCA9534_TRANSACTION_DEVICES_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Init(PCA9534_Transaction_t *Transaction,
+                         PCA9534_Handler_t **Handlers, uint8_t Count)
+{
+  uint8_t i = 0;
+
+  if (!Transaction || !Handlers || !Count ||
+      Count > PCA9534_TRANSACTION_DEVICES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < Count; i++)
+  {
+    if (!Handlers[i] || !Handlers[i]->Part)
+      return PCA9534_INVALID_PARAM;
+  }
+
+  Transaction->Handlers = Handlers;
+  Transaction->Count = Count;
+  Transaction->Open = 0;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Begin a transaction
+ * @param  Transaction: Pointer to transaction
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Begin(PCA9534_Transaction_t *Transaction)
+{
+  uint8_t i = 0;
+
+  if (!Transaction || !Transaction->Handlers)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < Transaction->Count; i++)
+  {
+    Transaction->Mask[i] = 0;
+    Transaction->Value[i] = 0;
+  }
+  Transaction->Open = 1;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Stage output values of pins of one device
+ * @param  Transaction: Pointer to transaction
+ * @param  Device: Index of device
+ * @param  Mask: Mask of pins to change
+ * @param  Value: Values of pins (1: High, 0: Low)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or no
+ *                                  transaction is open.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Stage(PCA9534_Transaction_t *Transaction, uint8_t Device,
+                          uint16_t Mask, uint16_t Value)
+{
+  if (!Transaction || !Transaction->Open || Device >= Transaction->Count)
+    return PCA9534_INVALID_PARAM;
+
+  Transaction->Mask[Device] |= Mask;
+  Transaction->Value[Device] &= ~Mask;
+  Transaction->Value[Device] |= Value & Mask;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Commit the staged values
+ * @note   The staged pins are merged into the current output shadows, so
+ *         only they are changed. Only the devices whose outputs change are
+ *         written, one transfer each. The skew is measured with GetTime of
+ *         the first handler, from the end of the first write to the end of
+ *         the last one.
+ * @param  Transaction: Pointer to transaction
+ * @param  Skew: Pointer to skew between devices in microseconds (can be NULL,
+ *               0 if GetTime is not linked or at most one device is written)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send data (the devices before the failed
+ *                         one are already written).
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or no
+ *                                  transaction is open.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Commit(PCA9534_Transaction_t *Transaction, uint32_t *Skew)
+{
+  PCA9534_Handler_t **Handlers = 0;
+  PCA9534_Platform_GetTime_t GetTime = 0;
+  uint8_t Order[PCA9534_TRANSACTION_DEVICES_MAX];
+  uint16_t Data[PCA9534_TRANSACTION_DEVICES_MAX];
+  uint8_t Count = 0;
+  uint32_t First = 0;
+  uint32_t Last = 0;
+  uint8_t i = 0;
+
+  if (!Transaction || !Transaction->Open)
+    return PCA9534_INVALID_PARAM;
+
+  Transaction->Open = 0;
+  Handlers = Transaction->Handlers;
+  GetTime = Handlers[0]->Platform.GetTime;
+  if (Skew)
+    *Skew = 0;
+
+  // Find the writes first, so nothing but writes runs between them
+  for (i = 0; i < Transaction->Count; i++)
+  {
+    Data[Count] = (Handlers[i]->RegOutput & ~Transaction->Mask[i]) |
+                  Transaction->Value[i];
+    if (Data[Count] != Handlers[i]->RegOutput)
+      Order[Count++] = i;
+  }
+
+  for (i = 0; i < Count; i++)
+  {
+    if (PCA9534_WriteAll(Handlers[Order[i]], Data[i]) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    if (GetTime)
+    {
+      Last = GetTime();
+      if (!i)
+        First = Last;
+    }
+  }
+
+  if (Skew)
+    *Skew = Last - First;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Drop the staged values
+ * @param  Transaction: Pointer to transaction
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Abort(PCA9534_Transaction_t *Transaction)
+{
+  if (!Transaction)
+    return PCA9534_INVALID_PARAM;
+
+  Transaction->Open = 0;
+
+  return PCA9534_OK;
+}
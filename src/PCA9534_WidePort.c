@@ -0,0 +1,290 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_WidePort.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Virtual wide port over multiple PCA9534 devices
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_WidePort.h"
+#if PCA9534_WIDEPORT_BMI2 && defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####
+ ==================================================================================
+ */
+
+static uint64_t
+WidePort_Pext(uint64_t x, uint64_t Mask)
+{
+#if PCA9534_WIDEPORT_BMI2 && defined(__BMI2__)
+  return _pext_u64(x, Mask);
+#else
+  uint64_t Result = 0;
+  uint64_t Bit = 1;
+
+  for (; Mask; Mask &= Mask - 1, Bit <<= 1)
+  {
+    if (x & Mask & (~Mask + 1))
+      Result |= Bit;
+  }
+
+  return Result;
+#endif
+}
+
+
+static uint64_t
+WidePort_Pdep(uint64_t x, uint64_t Mask)
+{
+#if PCA9534_WIDEPORT_BMI2 && defined(__BMI2__)
+  return _pdep_u64(x, Mask);
+#else
+  uint64_t Result = 0;
+  uint64_t Bit = 1;
+
+  for (; Mask; Mask &= Mask - 1, Bit <<= 1)
+  {
+    if (x & Bit)
+      Result |= Mask & (~Mask + 1);
+  }
+
+  return Result;
+#endif
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a wide port and compile its mapping
+ * @param  Port: Pointer to wide port
+ * @param  Handlers: Pointer to array of pointers to initialized handlers
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_WIDEPORT_DEVICES_MAX)
+ * @param  Map: Pointer to location of each bit (bit 0 first)
+ * @param  Width: Number of bits (1 <= Width <= PCA9534_WIDEPORT_BITS_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or two bits
+ *                                  are mapped to the same pin.
+ */
+PCA9534_Result_t
+PCA9534_WidePort_Init(PCA9534_WidePort_t *Port, PCA9534_Handler_t **Handlers,
+                      uint8_t DeviceCount, const PCA9534_WidePin_t *Map,
+                      uint8_t Width)
+{
+  uint16_t Used[PCA9534_WIDEPORT_DEVICES_MAX] = {0};
+  int8_t LastPin[PCA9534_WIDEPORT_DEVICES_MAX];
+  uint8_t Device = 0;
+  uint8_t Pin = 0;
+  uint8_t i = 0;
+
+  if (!Port || !Handlers || !Map)
+    return PCA9534_INVALID_PARAM;
+
+  if (!DeviceCount || DeviceCount > PCA9534_WIDEPORT_DEVICES_MAX ||
+      !Width || Width > PCA9534_WIDEPORT_BITS_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < DeviceCount; i++)
+  {
+    if (!Handlers[i] || !Handlers[i]->Part)
+      return PCA9534_INVALID_PARAM;
+
+    Port->BitMask[i] = 0;
+    Port->PinMask[i] = 0;
+    Port->Ordered[i] = 1;
+    LastPin[i] = -1;
+  }
+
+  for (i = 0; i < Width; i++)
+  {
+    Device = Map[i].Device;
+    Pin = Map[i].Pin;
+    if (Device >= DeviceCount || Pin >= Handlers[Device]->Part->Ports * 8 ||
+        (Used[Device] & (1 << Pin)))
+      return PCA9534_INVALID_PARAM;
+    Used[Device] |= (1 << Pin);
+
+    Port->BitMask[Device] |= (uint64_t)1 << i;
+    Port->PinMask[Device] |= (1 << Pin);
+    if ((int8_t)Pin < LastPin[Device])
+      Port->Ordered[Device] = 0;
+    LastPin[Device] = (int8_t)Pin;
+
+    Port->Map[i] = Map[i];
+  }
+
+  Port->Handlers = Handlers;
+  Port->DeviceCount = DeviceCount;
+  Port->Width = Width;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Write the wide port
+ * @note   Only the devices whose output pins change are written, one
+ *         transfer each. Unmapped pins keep their output values.
+ * @param  Port: Pointer to wide port
+ * @param  Data: Data to write
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_WidePort_Write(PCA9534_WidePort_t *Port, uint64_t Data)
+{
+  PCA9534_Handler_t *Handler = 0;
+  uint16_t Pins = 0;
+  uint8_t Device = 0;
+
+  if (!Port || !Port->Handlers)
+    return PCA9534_INVALID_PARAM;
+
+  for (Device = 0; Device < Port->DeviceCount; Device++)
+  {
+    if (!Port->PinMask[Device])
+      continue;
+
+    Handler = Port->Handlers[Device];
+    Pins = (Handler->RegOutput & ~Port->PinMask[Device]) |
+           PCA9534_WidePort_Scatter(Port, Device, Data);
+    if (Pins == Handler->RegOutput)
+      continue;
+
+    if (PCA9534_WriteAll(Handler, Pins) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Read the wide port
+ * @note   The devices are read in one sweep, one transfer each.
+ * @param  Port: Pointer to wide port
+ * @param  Data: Pointer to data
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_WidePort_Read(PCA9534_WidePort_t *Port, uint64_t *Data)
+{
+  uint64_t Value = 0;
+  uint16_t Pins = 0;
+  uint8_t Device = 0;
+
+  if (!Port || !Port->Handlers || !Data)
+    return PCA9534_INVALID_PARAM;
+
+  for (Device = 0; Device < Port->DeviceCount; Device++)
+  {
+    if (!Port->PinMask[Device])
+      continue;
+
+    if (PCA9534_ReadAll(Port->Handlers[Device], &Pins) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    Value |= PCA9534_WidePort_Gather(Port, Device, Pins);
+  }
+
+  *Data = Value;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Scatter a wide port value to the pins of one device
+ * @param  Port: Pointer to wide port
+ * @param  Device: Index of device
+ * @param  Data: Wide port value
+ * @retval Pin values of device (unmapped pins are 0)
+ */
+uint16_t
+PCA9534_WidePort_Scatter(const PCA9534_WidePort_t *Port, uint8_t Device,
+                         uint64_t Data)
+{
+  uint16_t Pins = 0;
+  uint8_t i = 0;
+
+  if (Port->Ordered[Device])
+    return (uint16_t)WidePort_Pdep(WidePort_Pext(Data, Port->BitMask[Device]),
+                                   Port->PinMask[Device]);
+
+  for (i = 0; i < Port->Width; i++)
+  {
+    if (Port->Map[i].Device == Device && ((Data >> i) & 0x01))
+      Pins |= (1 << Port->Map[i].Pin);
+  }
+
+  return Pins;
+}
+
+
+/**
+ * @brief  Gather the pins of one device into a wide port value
+ * @param  Port: Pointer to wide port
+ * @param  Device: Index of device
+ * @param  Pins: Pin values of device
+ * @retval Wide port value (bits of other devices are 0)
+ */
+uint64_t
+PCA9534_WidePort_Gather(const PCA9534_WidePort_t *Port, uint8_t Device,
+                        uint16_t Pins)
+{
+  uint64_t Value = 0;
+  uint8_t i = 0;
+
+  if (Port->Ordered[Device])
+    return WidePort_Pdep(WidePort_Pext(Pins, Port->PinMask[Device]),
+                         Port->BitMask[Device]);
+
+  for (i = 0; i < Port->Width; i++)
+  {
+    if (Port->Map[i].Device == Device && ((Pins >> Port->Map[i].Pin) & 0x01))
+      Value |= (uint64_t)1 << i;
+  }
+
+  return Value;
+}
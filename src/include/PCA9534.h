@@ -41,6 +41,55 @@ extern "C" {
 #include <stdint.h>
 
 
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Enable performance counters and latency histograms
+ * @note   If it is 0, the counters are compiled out and cost nothing.
+ */
+#ifndef PCA9534_CONFIG_STATS
+#define PCA9534_CONFIG_STATS            0
+#endif
+
+/**
+ * @brief  Number of log2 buckets of latency histograms
+ */
+#define PCA9534_STATS_LATENCY_BUCKETS   16
+
+/**
+ * @brief  Enable USDT (sys/sdt.h) static probes of provider "pca9534"
+ * @note   Probes:
+ *         - func__entry(Function, AddressI2C)
+ *         - func__return(Function, AddressI2C, Result)
+ *         - send__entry(AddressI2C, Register, Len)
+ *         - send__return(AddressI2C, Register, Len, Result)
+ *         - receive__entry(AddressI2C, Register, Len)
+ *         - receive__return(AddressI2C, Register, Len, Result)
+ *         Len is the number of register data bytes of the transfer.
+ */
+#ifndef PCA9534_CONFIG_TRACE
+#define PCA9534_CONFIG_TRACE            0
+#endif
+
+/**
+ * @brief  Bind the platform Send and Receive functions at compile time
+ * @note   If it is 1, the driver calls PCA9534_PLATFORM_SEND and
+ *         PCA9534_PLATFORM_RECEIVE directly instead of the Send and Receive
+ *         pointers of the handler, so the transport can be inlined into the
+ *         register accesses. They must be defined (as functions or macros with
+ *         the PCA9534_Platform_SendReceive_t signature) in the header named by
+ *         PCA9534_PLATFORM_HEADER, which is included by PCA9534.c only.
+ * @note   The Send and Receive pointers of the handler are not used by
+ *         PCA9534.c, but the other modules still use them. Modules that hook
+ *         the pointers of a handler to see or replace its traffic (the
+ *         recorder and the replayer in port/Recorder) do not work in this
+ *         mode: PCA9534_Recorder_Attach returns PCA9534_INVALID_PARAM.
+ */
+#ifndef PCA9534_CONFIG_PLATFORM_STATIC
+#define PCA9534_CONFIG_PLATFORM_STATIC  0
+#endif
+
+
+
 /* Exported Data Types ----------------------------------------------------------*/
 /**
  * @brief  Library functions result data type
@@ -59,8 +108,57 @@ typedef enum PCA9534_Device_e
 {
   PCA9534_DEVICE_PCA9534 = 0,
   PCA9534_DEVICE_PCA9534A = 1,
+  PCA9534_DEVICE_PCA9535 = 2,
+  PCA9534_DEVICE_PCA9555 = 3,
+  PCA9534_DEVICE_TCA9535 = 4,
+  PCA9534_DEVICE_PCAL9534 = 5,
+  PCA9534_DEVICE_PCAL6408 = 6,
+  PCA9534_DEVICE_PCAL9535 = 7,
+  PCA9534_DEVICE_PCAL6416 = 8,
+  PCA9534_DEVICE_PCA9554 = 9,
+  PCA9534_DEVICE_PCA9554A = 10,
+  PCA9534_DEVICE_TCA9534 = 11,
+  PCA9534_DEVICE_TCA9554 = 12,
+  PCA9534_DEVICE_COUNT = 13,
 } PCA9534_Device_t;
 
+/**
+ * @brief  Part descriptor data type
+ */
+typedef struct PCA9534_Part_s
+{
+  const char *Name;
+
+  // I2C address with all address pins low
+  uint8_t AddressBase;
+  // Number of address pins
+  uint8_t AddressPins;
+
+  // Number of 8-bit ports (1 or 2)
+  uint8_t Ports;
+  // Number of registers
+  uint8_t Registers;
+
+  // Maximum SCL clock in kHz
+  uint16_t MaxClock;
+
+  // Register pairs are moved in one transfer
+  uint8_t AutoIncrement;
+  // Has Agile I/O registers (PCAL devices)
+  uint8_t Agile;
+} PCA9534_Part_t;
+
+/**
+ * @brief  Output drive strength of Agile I/O devices
+ */
+typedef enum PCA9534_Drive_e
+{
+  PCA9534_DRIVE_0_25 = 0,
+  PCA9534_DRIVE_0_50 = 1,
+  PCA9534_DRIVE_0_75 = 2,
+  PCA9534_DRIVE_1_00 = 3,
+} PCA9534_Drive_t;
+
 
 /**
  * @brief  Function type for Initialize/Deinitialize the platform dependent layer.
@@ -84,11 +182,18 @@ typedef int8_t (*PCA9534_Platform_InitDeinit_t)(void);
 typedef int8_t (*PCA9534_Platform_SendReceive_t)(uint8_t Address,
                                                  uint8_t *Data, uint8_t Len);
 
+/**
+ * @brief  Function type for reading a monotonic clock
+ * @retval Time in microseconds (it may wrap around)
+ */
+typedef uint32_t (*PCA9534_Platform_GetTime_t)(void);
+
 /**
  * @brief  Platform dependent layer data type
  * @note   It is optional to initialize this functions:
  *         - Init
  *         - DeInit
+ *         - GetTime (used for latency histograms)
  * @note   It is mandatory to initialize this functions:
  *         - Send
  *         - Receive
@@ -105,9 +210,48 @@ typedef struct PCA9534_Platform_s
   PCA9534_Platform_SendReceive_t Send;
   // Receive data from the slave
   PCA9534_Platform_SendReceive_t Receive;
+
+  // Read monotonic clock
+  PCA9534_Platform_GetTime_t GetTime;
 } PCA9534_Platform_t;
 
 
+/**
+ * @brief  Operation types of latency histograms
+ */
+typedef enum PCA9534_StatsOp_e
+{
+  PCA9534_STATS_OP_WRITE  = 0,
+  PCA9534_STATS_OP_READ   = 1,
+  PCA9534_STATS_OP_COUNT  = 2,
+} PCA9534_StatsOp_t;
+
+/**
+ * @brief  Performance counters data type
+ * @note   Bucket 0 of latency histograms counts latencies below 2us and
+ *         bucket i counts latencies in [2^i, 2^(i+1)) us. The last bucket
+ *         also counts all longer latencies.
+ */
+typedef struct PCA9534_Stats_s
+{
+  // Bus transactions (Send or Receive calls)
+  uint32_t Transactions;
+  // Bytes moved on the bus
+  uint32_t Bytes;
+
+  // Failed transactions by kind
+  uint32_t FailError;
+  uint32_t FailBusy;
+  uint32_t FailNAck;
+
+  // Register reads served from the shadow copy
+  uint32_t CacheHits;
+
+  // Latency histograms of register operations
+  uint32_t Latency[PCA9534_STATS_OP_COUNT][PCA9534_STATS_LATENCY_BUCKETS];
+} PCA9534_Stats_t;
+
+
 /**
  * @brief  Handler data type
  * @note   User must initialize platform dependent layer functions
@@ -120,8 +264,35 @@ typedef struct PCA9534_Handler_s
   // I2C Address
   uint8_t AddressI2C;
 
+  // Descriptor of part
+  const PCA9534_Part_t *Part;
+
+  // Shadow copy of Output, Polarity Inversion and Configuration registers
+  // (port 0 in the low byte)
+  uint16_t RegOutput;
+  uint16_t RegPolarity;
+  uint16_t RegConfig;
+
+  // Shadow copy of Agile I/O registers
+  uint32_t RegDrive;
+  uint16_t RegLatch;
+  uint16_t RegPullEnable;
+  uint16_t RegPullSelect;
+  uint16_t RegIntMask;
+  uint8_t RegOutputConfig;
+
+  // Bus transactions between two scrubs (0: scrub disabled)
+  uint16_t ScrubInterval;
+  // Bus transactions since the last scrub
+  uint16_t ScrubCounter;
+
   // Platform dependent layer
   PCA9534_Platform_t Platform;
+
+#if PCA9534_CONFIG_STATS
+  // Performance counters
+  PCA9534_Stats_t Stats;
+#endif
 } PCA9534_Handler_t;
 
 
@@ -158,6 +329,14 @@ typedef struct PCA9534_Handler_s
 #define PCA9534_PLATFORM_LINK_RECEIVE(HANDLER, FUNC) \
   (HANDLER)->Platform.Receive = FUNC
 
+/**
+ * @brief  Link platform dependent layer functions to handler
+ * @param  HANDLER: Pointer to handler
+ * @param  FUNC: Function name
+ */
+#define PCA9534_PLATFORM_LINK_GETTIME(HANDLER, FUNC) \
+  (HANDLER)->Platform.GetTime = FUNC
+
 
 
 
@@ -173,7 +352,7 @@ typedef struct PCA9534_Handler_s
  *         layer and before using other functions.
  * @param  Handler: Pointer to handler
  * @param  Device: Device type
- * @param  Address: Address pins state (0 <= Address <= 7)
+ * @param  Address: Address pins state (0 <= Address < 2^AddressPins of part)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
  *         - PCA9534_FAIL: Failed to send or receive data.
@@ -184,6 +363,24 @@ PCA9534_Init(PCA9534_Handler_t *Handler, PCA9534_Device_t Device,
              uint8_t Address);
 
 
+/**
+ * @brief  Initializer function for a device that is already running
+ * @note   Unlike PCA9534_Init, no register is written: the shadow copies are
+ *         read back from the device, so its outputs and configuration are
+ *         kept. Use it to take over a device without glitching its pins.
+ * @param  Handler: Pointer to handler
+ * @param  Device: Device type
+ * @param  Address: Address pins state (0 <= Address < 2^AddressPins of part)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: Invalid parameter.
+ */
+PCA9534_Result_t
+PCA9534_InitFromDevice(PCA9534_Handler_t *Handler, PCA9534_Device_t Device,
+                       uint8_t Address);
+
+
 /**
  * @brief  Deinitialize function
  * @param  Handler: Pointer to handler
@@ -198,7 +395,7 @@ PCA9534_DeInit(PCA9534_Handler_t *Handler);
 /**
  * @brief  Set I2C Address
  * @param  Handler: Pointer to handler
- * @param  Address: Address pins state (0 <= Address <= 7)
+ * @param  Address: Address pins state (0 <= Address < 2^AddressPins of part)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
  *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
@@ -207,6 +404,31 @@ PCA9534_Result_t
 PCA9534_SetAddressI2C(PCA9534_Handler_t *Handler, uint8_t Address);
 
 
+/**
+ * @brief  Get the descriptor of a part
+ * @param  Device: Device type
+ * @retval Pointer to descriptor (NULL if Device is invalid)
+ */
+const PCA9534_Part_t *
+PCA9534_GetPart(PCA9534_Device_t Device);
+
+
+/**
+ * @brief  Fastest legal SCL clock of a bus
+ * @note   Every device on a bus sees all the traffic, so the bus must not run
+ *         faster than its slowest device.
+ * @param  Handlers: Pointer to array of pointers to initialized handlers
+ * @param  Count: Number of handlers
+ * @param  Clock: Pointer to clock in kHz
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_GetBusClock(PCA9534_Handler_t **Handlers, uint8_t Count,
+                    uint16_t *Clock);
+
+
 
 /**
  ==================================================================================
@@ -216,6 +438,7 @@ PCA9534_SetAddressI2C(PCA9534_Handler_t *Handler, uint8_t Address);
 
 /**
  * @brief  Set direction of pins
+ * @note   On 16-bit devices only port 0 is changed.
  * @param  Handler: Pointer to handler
  * @param  Dir: Direction of pins (1: Output, 0: Input)
  * @retval PCA9534_Result_t
@@ -229,7 +452,7 @@ PCA9534_SetDir(PCA9534_Handler_t *Handler, uint8_t Dir);
 /**
  * @brief  Set the direction of one bit
  * @param  Handler: Pointer to handler
- * @param  Pos: Position of bit (0 <= Pos <= 7)
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
  * @param  Dir: Direction of bit (1: Output, 0: Input)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
@@ -242,6 +465,7 @@ PCA9534_SetDirOne(PCA9534_Handler_t *Handler, uint8_t Pos, uint8_t Dir);
 
 /**
  * @brief  Read data from the device
+ * @note   On 16-bit devices only port 0 is read.
  * @param  Handler: Pointer to handler
  * @param  Data: Pointer to data
  * @retval PCA9534_Result_t
@@ -255,6 +479,7 @@ PCA9534_Read(PCA9534_Handler_t *Handler, uint8_t *Data);
 
 /**
  * @brief  Write data to the device
+ * @note   On 16-bit devices only port 0 is changed.
  * @param  Handler: Pointer to handler
  * @param  Data: Data to write
  * @retval PCA9534_Result_t
@@ -268,7 +493,7 @@ PCA9534_Write(PCA9534_Handler_t *Handler, uint8_t Data);
 /**
  * @brief  Write data to the one bit
  * @param  Handler: Pointer to handler
- * @param  Pos: Position of bit (0 <= Pos <= 7)
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
  * @param  Value: Value to write (1: High, 0: Low)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
@@ -281,6 +506,7 @@ PCA9534_WriteOne(PCA9534_Handler_t *Handler, uint8_t Pos, uint8_t Value);
 
 /**
  * @brief  Toggle the output bits
+ * @note   On 16-bit devices only port 0 is changed.
  * @param  Handler: Pointer to handler
  * @param  Mask: Mask of bits to toggle
  * @retval PCA9534_Result_t
@@ -294,7 +520,7 @@ PCA9534_Toggle(PCA9534_Handler_t *Handler, uint8_t Mask);
 /**
  * @brief  Toggle the one bit
  * @param  Handler: Pointer to handler
- * @param  Pos: Position of bit (0 <= Pos <= 7)
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
  * @retval PCA9534_Result_t
  *         - PCA9534_OK: Operation was successful.
  *         - PCA9534_FAIL: Failed to send or receive data.
@@ -305,6 +531,239 @@ PCA9534_ToggleOne(PCA9534_Handler_t *Handler, uint8_t Pos);
 
 
 
+/**
+ * @brief  Set direction of all pins in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Dir: Direction of pins (1: Output, 0: Input), port 0 in the low byte
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ */
+PCA9534_Result_t
+PCA9534_SetDirAll(PCA9534_Handler_t *Handler, uint16_t Dir);
+
+
+/**
+ * @brief  Read all ports of the device in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Data: Pointer to data (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: Invalid parameter.
+ */
+PCA9534_Result_t
+PCA9534_ReadAll(PCA9534_Handler_t *Handler, uint16_t *Data);
+
+
+/**
+ * @brief  Write all ports of the device in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Data: Data to write (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ */
+PCA9534_Result_t
+PCA9534_WriteAll(PCA9534_Handler_t *Handler, uint16_t Data);
+
+
+/**
+ * @brief  Toggle the output bits of all ports in one transfer
+ * @param  Handler: Pointer to handler
+ * @param  Mask: Mask of bits to toggle (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ */
+PCA9534_Result_t
+PCA9534_ToggleAll(PCA9534_Handler_t *Handler, uint16_t Mask);
+
+
+
+/**
+ ==================================================================================
+                         ##### Agile I/O Functions #####                          
+ ==================================================================================
+ */
+
+/**
+ * @brief  Enable the input latch of pins
+ * @note   A latched pin keeps a change in the Input Port register until it is
+ *         read, so short pulses between two reads are not lost.
+ * @param  Handler: Pointer to handler
+ * @param  Latch: Mask of latched pins (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: The device has no Agile I/O registers.
+ */
+PCA9534_Result_t
+PCA9534_SetInputLatch(PCA9534_Handler_t *Handler, uint16_t Latch);
+
+
+/**
+ * @brief  Set the pull-up/pull-down resistors of pins
+ * @param  Handler: Pointer to handler
+ * @param  Enable: Mask of pins with a pull resistor (port 0 in the low byte)
+ * @param  Up: Direction of pull resistors (1: Pull-up, 0: Pull-down)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: The device has no Agile I/O registers.
+ */
+PCA9534_Result_t
+PCA9534_SetPull(PCA9534_Handler_t *Handler, uint16_t Enable, uint16_t Up);
+
+
+/**
+ * @brief  Set the output drive strength of one bit
+ * @param  Handler: Pointer to handler
+ * @param  Pos: Position of bit (0 <= Pos <= 7, 15 for 16-bit devices)
+ * @param  Drive: Drive strength
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SetDriveStrength(PCA9534_Handler_t *Handler, uint8_t Pos,
+                         PCA9534_Drive_t Drive);
+
+
+/**
+ * @brief  Set the output stage of ports
+ * @param  Handler: Pointer to handler
+ * @param  Ports: Mask of open-drain ports (bit 0: Port 0, bit 1: Port 1),
+ *                the other ports are push-pull
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SetOpenDrain(PCA9534_Handler_t *Handler, uint8_t Ports);
+
+
+/**
+ * @brief  Enable the interrupt of pins
+ * @param  Handler: Pointer to handler
+ * @param  Enable: Mask of pins that assert INT (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: The device has no Agile I/O registers.
+ */
+PCA9534_Result_t
+PCA9534_SetIntEnable(PCA9534_Handler_t *Handler, uint16_t Enable);
+
+
+/**
+ * @brief  Read the interrupt status
+ * @note   The status is cleared by reading the input port.
+ * @param  Handler: Pointer to handler
+ * @param  Status: Pointer to mask of pins that caused the interrupt
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_GetIntStatus(PCA9534_Handler_t *Handler, uint16_t *Status);
+
+
+/**
+ * @brief  Handle an interrupt of the device
+ * @note   The interrupt status and then the input port are read, which
+ *         clears the interrupt and the input latch. No diff against a
+ *         previous input value is needed to find the changed pins.
+ * @param  Handler: Pointer to handler
+ * @param  Status: Pointer to mask of pins that caused the interrupt
+ * @param  Data: Pointer to input data (port 0 in the low byte)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_ReadInt(PCA9534_Handler_t *Handler, uint16_t *Status, uint16_t *Data);
+
+
+
+/**
+ ==================================================================================
+                           ##### Supervisor Functions #####                        
+ ==================================================================================
+ */
+
+/**
+ * @brief  Set the scrub interval
+ * @note   One scrub costs at most one register read, so the scrub takes about
+ *         1/Interval of the bus transactions issued by the driver. Skipped
+ *         calls of PCA9534_Scrub are counted as idle bus slots, so an idle
+ *         device is still scrubbed every Interval calls.
+ * @param  Handler: Pointer to handler
+ * @param  Interval: Bus transactions between two scrubs (0: Disable scrub)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SetScrubInterval(PCA9534_Handler_t *Handler, uint16_t Interval);
+
+
+/**
+ * @brief  Rate-limited check for device reset or re-plug
+ * @note   The first register whose shadow differs from its power-on default is
+ *         read back and compared. On mismatch the registers are rewritten from
+ *         the shadow copy. If the device was reset, only the registers that
+ *         differ from their power-on defaults are written (Output first, so
+ *         the outputs are driven with the right level when enabled).
+ * @param  Handler: Pointer to handler
+ * @param  Restored: Pointer to a flag set to 1 if the registers were rewritten
+ *                   (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: Invalid parameter.
+ */
+PCA9534_Result_t
+PCA9534_Scrub(PCA9534_Handler_t *Handler, uint8_t *Restored);
+
+
+
+#if PCA9534_CONFIG_STATS
+/**
+ ==================================================================================
+                           ##### Statistics Functions #####                        
+ ==================================================================================
+ */
+
+/**
+ * @brief  Take a snapshot of performance counters
+ * @param  Handler: Pointer to handler
+ * @param  Stats: Pointer to snapshot
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_GetStats(PCA9534_Handler_t *Handler, PCA9534_Stats_t *Stats);
+
+
+/**
+ * @brief  Reset performance counters
+ * @param  Handler: Pointer to handler
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_ResetStats(PCA9534_Handler_t *Handler);
+#endif
+
+
+
 #ifdef __cplusplus
 }
 #endif
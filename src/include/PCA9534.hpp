@@ -0,0 +1,570 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534.hpp
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  C++ compile-time wrapper of the PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_PCA9534_HPP_
+#define _PCA9534_HPP_
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+namespace PCA9534
+{
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Register addresses (port 0 register of 8-bit devices)
+ */
+constexpr uint8_t REG_INPUT_PORT      = 0x00;
+constexpr uint8_t REG_OUTPUT_PORT     = 0x01;
+constexpr uint8_t REG_POLARITY_INVERT = 0x02;
+constexpr uint8_t REG_CONFIGURATION   = 0x03;
+constexpr uint8_t REG_INPUT_LATCH     = 0x42;
+constexpr uint8_t REG_PULL_ENABLE     = 0x43;
+constexpr uint8_t REG_PULL_SELECT     = 0x44;
+constexpr uint8_t REG_INT_MASK        = 0x45;
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Part properties known at compile time
+ */
+struct PartInfo
+{
+  // I2C address with all address pins low
+  uint8_t AddressBase;
+  // Number of address pins
+  uint8_t AddressPins;
+  // Number of 8-bit ports (1 or 2)
+  uint8_t Ports;
+  // Register pairs are moved in one transfer
+  uint8_t AutoIncrement;
+  // Has Agile I/O registers (PCAL devices)
+  uint8_t Agile;
+};
+
+/**
+ * @brief  Part properties (in order of PCA9534_Device_t, same as the
+ *         descriptors returned by PCA9534_GetPart)
+ */
+inline constexpr PartInfo Parts[PCA9534_DEVICE_COUNT] =
+{
+  // AddressBase  AddrPins Ports AutoInc Agile
+  {0x20,          3,       1,    0,      0},  // PCA9534
+  {0x38,          3,       1,    0,      0},  // PCA9534A
+  {0x20,          3,       2,    1,      0},  // PCA9535
+  {0x20,          3,       2,    1,      0},  // PCA9555
+  {0x20,          3,       2,    1,      0},  // TCA9535
+  {0x20,          3,       1,    0,      1},  // PCAL9534
+  {0x20,          1,       1,    0,      1},  // PCAL6408
+  {0x20,          3,       2,    1,      1},  // PCAL9535
+  {0x20,          1,       2,    1,      1},  // PCAL6416
+  {0x20,          3,       1,    0,      0},  // PCA9554
+  {0x38,          3,       1,    0,      0},  // PCA9554A
+  {0x20,          3,       1,    0,      0},  // TCA9534
+  {0x20,          3,       1,    0,      0},  // TCA9554
+};
+
+#if defined(__cpp_concepts)
+/**
+ * @brief  Bus of Expander: static platform dependent functions
+ */
+template <class Bus>
+concept BusType = requires(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  Bus::Send(Address, Data, DataLen);
+  Bus::Receive(Address, Data, DataLen);
+};
+#endif
+
+/**
+ * @brief  Bus of a platform dependent layer linked at run time
+ * @note   Calls go through the Send and Receive pointers of Platform, so this
+ *         is for transports that are only known at run time. Compile-time
+ *         transports should be given to Expander as their own Bus class.
+ * @param  Platform: Platform dependent layer (static storage duration)
+ */
+template <PCA9534_Platform_t &Platform>
+struct PlatformBus
+{
+  static int8_t
+  Send(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+  {
+    return Platform.Send(Address, Data, DataLen);
+  }
+
+  static int8_t
+  Receive(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+  {
+    return Platform.Receive(Address, Data, DataLen);
+  }
+};
+
+
+/**
+ * @brief  I/O expander bound to a part, an address and a bus at compile time
+ * @note   Bus must provide the platform dependent functions as static members:
+ *         - static int8_t Send(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+ *         - static int8_t Receive(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+ *         They are called directly, so they can be inlined into every access.
+ * @note   Part, address pins and pin numbers are checked by the compiler and
+ *         register addresses and transfer lengths are constants, so there is
+ *         no parameter checking at run time. Only the ports a pin group lies
+ *         in are transferred.
+ * @param  Part: Device type
+ * @param  AddressPins: Address pins state (0 <= AddressPins < 2^AddressPins of part)
+ * @param  Bus: Platform dependent layer
+ */
+template <PCA9534_Device_t Part, uint8_t AddressPins, class Bus>
+class Expander
+{
+  static_assert((unsigned)Part < PCA9534_DEVICE_COUNT, "Unknown device");
+  static_assert(AddressPins < (1u << Parts[Part].AddressPins),
+                "Address pins state out of range for this part");
+#if defined(__cpp_concepts)
+  static_assert(BusType<Bus>, "Bus must provide static Send and Receive");
+#endif
+
+public:
+  static constexpr PartInfo Info = Parts[Part];
+
+  // I2C address
+  static constexpr uint8_t AddressI2C = Info.AddressBase | AddressPins;
+
+  // Number of pins
+  static constexpr uint8_t Width = Info.Ports * 8;
+
+  // Mask of the pins of the device
+  static constexpr uint16_t PinMask = (uint16_t)((1UL << Width) - 1);
+
+
+  /**
+   * @brief  Group of pins of the expander
+   * @param  Mask: Mask of pins (port 0 in the low byte)
+   */
+  template <uint16_t Mask>
+  class PinGroup
+  {
+    static_assert(Mask != 0, "Empty pin group");
+    static_assert((Mask & ~PinMask) == 0, "Pin out of range for this part");
+
+  public:
+    explicit constexpr PinGroup(Expander &Device) : Owner(Device) {}
+
+    /**
+     * @brief  Set direction of pins
+     * @param  Dir: Direction of pins (1: Output, 0: Input)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    SetDir(uint16_t Dir)
+    {
+      return Owner.template Update<REG_CONFIGURATION, Mask>(Owner.RegConfig,
+                                                             (uint16_t)~Dir);
+    }
+
+    /**
+     * @brief  Write data to the pins
+     * @param  Value: Data to write (bits outside Mask are ignored)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Write(uint16_t Value)
+    {
+      return Owner.template Update<REG_OUTPUT_PORT, Mask>(Owner.RegOutput,
+                                                           Value);
+    }
+
+    /**
+     * @brief  Drive the pins high
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Set()
+    {
+      return Write(Mask);
+    }
+
+    /**
+     * @brief  Drive the pins low
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Clear()
+    {
+      return Write(0);
+    }
+
+    /**
+     * @brief  Toggle the pins
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Toggle()
+    {
+      return Write((uint16_t)~Owner.RegOutput);
+    }
+
+    /**
+     * @brief  Read the pins
+     * @param  Value: Data read (bits outside Mask are 0)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Read(uint16_t &Value)
+    {
+      uint16_t Data = 0;
+
+      if (Owner.template ReadReg<REG_INPUT_PORT, Mask>(Data) != PCA9534_OK)
+        return PCA9534_FAIL;
+
+      Value = Data & Mask;
+      return PCA9534_OK;
+    }
+
+    /**
+     * @brief  Set the input polarity inversion of pins
+     * @param  Invert: Inversion of pins (1: Inverted, 0: Retained)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    SetPolarity(uint16_t Invert)
+    {
+      return Owner.template Update<REG_POLARITY_INVERT, Mask>(Owner.RegPolarity,
+                                                               Invert);
+    }
+
+    /**
+     * @brief  Configure the pull-up/pull-down resistors of pins (PCAL devices)
+     * @param  Enable: Resistor enable of pins (1: Enabled, 0: Disabled)
+     * @param  Up: Resistor direction of pins (1: Pull-up, 0: Pull-down)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    SetPull(uint16_t Enable, uint16_t Up)
+    {
+      static_assert(Info.Agile, "Pull resistors need an Agile I/O part");
+
+      // Direction first, so an enabled resistor never pulls the wrong way
+      if (Owner.template Update<REG_PULL_SELECT, Mask>(Owner.RegPullSelect,
+                                                       Up) != PCA9534_OK)
+        return PCA9534_FAIL;
+
+      return Owner.template Update<REG_PULL_ENABLE, Mask>(Owner.RegPullEnable,
+                                                          Enable);
+    }
+
+  protected:
+    Expander &Owner;
+  };
+
+
+  /**
+   * @brief  One pin of the expander
+   * @param  N: Position of pin (0 <= N < Width)
+   */
+  template <uint8_t N>
+  class Pin : public PinGroup<(uint16_t)(1u << (N % 16))>
+  {
+    static_assert(N < Width, "Pin out of range for this part");
+
+    using Group = PinGroup<(uint16_t)(1u << (N % 16))>;
+
+  public:
+    explicit constexpr Pin(Expander &Device) : Group(Device) {}
+
+    /**
+     * @brief  Set direction of the pin
+     * @param  Dir: Direction of pin (1: Output, 0: Input)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    SetDir(bool Dir)
+    {
+      return Group::SetDir(Dir ? 0xFFFF : 0);
+    }
+
+    /**
+     * @brief  Write data to the pin
+     * @param  Value: Value to write (1: High, 0: Low)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Write(bool Value)
+    {
+      return Group::Write(Value ? 0xFFFF : 0);
+    }
+
+    /**
+     * @brief  Read the pin
+     * @param  Value: Value read (1: High, 0: Low)
+     * @retval PCA9534_Result_t
+     *         - PCA9534_OK: Operation was successful.
+     *         - PCA9534_FAIL: Failed to send or receive data.
+     */
+    PCA9534_Result_t
+    Read(bool &Value)
+    {
+      uint16_t Data = 0;
+
+      if (Group::Read(Data) != PCA9534_OK)
+        return PCA9534_FAIL;
+
+      Value = (Data != 0);
+      return PCA9534_OK;
+    }
+  };
+
+
+  /**
+   * @brief  Write the power-on default values to the device
+   * @note   Output, Polarity Inversion, the pull resistor registers (Agile
+   *         parts) and Configuration are written, in the same order as
+   *         PCA9534_Init. The other Agile registers are not used by the class
+   *         and are left as they are.
+   * @retval PCA9534_Result_t
+   *         - PCA9534_OK: Operation was successful.
+   *         - PCA9534_FAIL: Failed to send or receive data.
+   */
+  PCA9534_Result_t
+  Init()
+  {
+    RegOutput = PinMask;
+    RegPolarity = 0;
+    RegConfig = PinMask;
+    RegPullEnable = 0;
+    RegPullSelect = PinMask;
+
+    if (WriteReg<REG_OUTPUT_PORT, PinMask>(RegOutput) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    if (WriteReg<REG_POLARITY_INVERT, PinMask>(RegPolarity) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    if constexpr (Info.Agile)
+    {
+      if (WriteReg<REG_PULL_SELECT, PinMask>(RegPullSelect) != PCA9534_OK)
+        return PCA9534_FAIL;
+
+      if (WriteReg<REG_PULL_ENABLE, PinMask>(RegPullEnable) != PCA9534_OK)
+        return PCA9534_FAIL;
+    }
+
+    return WriteReg<REG_CONFIGURATION, PinMask>(RegConfig);
+  }
+
+  /**
+   * @brief  Set direction of all pins
+   * @param  Dir: Direction of pins (1: Output, 0: Input)
+   * @retval PCA9534_Result_t
+   *         - PCA9534_OK: Operation was successful.
+   *         - PCA9534_FAIL: Failed to send or receive data.
+   */
+  PCA9534_Result_t
+  SetDir(uint16_t Dir)
+  {
+    return PinGroup<PinMask>(*this).SetDir(Dir);
+  }
+
+  /**
+   * @brief  Read all pins of the device in one transfer
+   * @param  Data: Data read (port 0 in the low byte)
+   * @retval PCA9534_Result_t
+   *         - PCA9534_OK: Operation was successful.
+   *         - PCA9534_FAIL: Failed to send or receive data.
+   */
+  PCA9534_Result_t
+  Read(uint16_t &Data)
+  {
+    return PinGroup<PinMask>(*this).Read(Data);
+  }
+
+  /**
+   * @brief  Write all pins of the device in one transfer
+   * @param  Data: Data to write (port 0 in the low byte)
+   * @retval PCA9534_Result_t
+   *         - PCA9534_OK: Operation was successful.
+   *         - PCA9534_FAIL: Failed to send or receive data.
+   */
+  PCA9534_Result_t
+  Write(uint16_t Data)
+  {
+    return PinGroup<PinMask>(*this).Write(Data);
+  }
+
+  /**
+   * @brief  Toggle the output bits
+   * @param  Mask: Mask of bits to toggle
+   * @retval PCA9534_Result_t
+   *         - PCA9534_OK: Operation was successful.
+   *         - PCA9534_FAIL: Failed to send or receive data.
+   */
+  PCA9534_Result_t
+  Toggle(uint16_t Mask)
+  {
+    return Write(RegOutput ^ Mask);
+  }
+
+  /**
+   * @brief  Shadow copy of the Output register
+   */
+  uint16_t
+  GetOutput() const
+  {
+    return RegOutput;
+  }
+
+private:
+  // First and last port of the pins of Mask
+  template <uint16_t Mask>
+  static constexpr uint8_t FirstPort = (Mask & 0x00FF) ? 0 : 1;
+  template <uint16_t Mask>
+  static constexpr uint8_t LastPort = (Mask & 0xFF00) ? 1 : 0;
+
+  // Address of the register of port Port on the device
+  static constexpr uint8_t
+  RegAddress(uint8_t Reg, uint8_t Port)
+  {
+    return (uint8_t)(((Reg & 0x40) | ((Reg & 0x3F) * Info.Ports)) + Port);
+  }
+
+  template <uint8_t Reg, uint16_t Mask>
+  PCA9534_Result_t
+  WriteReg(uint16_t Value)
+  {
+    constexpr uint8_t First = FirstPort<Mask>;
+    constexpr uint8_t Count = LastPort<Mask> - First + 1;
+
+    if constexpr (Count == 1 || Info.AutoIncrement)
+    {
+      uint8_t Buffer[1 + Count] = {RegAddress(Reg, First)};
+
+      for (uint8_t i = 0; i < Count; i++)
+        Buffer[1 + i] = (uint8_t)(Value >> ((First + i) * 8));
+
+      if (Bus::Send(AddressI2C, Buffer, 1 + Count) < 0)
+        return PCA9534_FAIL;
+    }
+    else
+    {
+      for (uint8_t Port = First; Port < First + Count; Port++)
+      {
+        uint8_t Buffer[2] = {RegAddress(Reg, Port),
+                             (uint8_t)(Value >> (Port * 8))};
+
+        if (Bus::Send(AddressI2C, Buffer, 2) < 0)
+          return PCA9534_FAIL;
+      }
+    }
+
+    return PCA9534_OK;
+  }
+
+  template <uint8_t Reg, uint16_t Mask>
+  PCA9534_Result_t
+  ReadReg(uint16_t &Value)
+  {
+    constexpr uint8_t First = FirstPort<Mask>;
+    constexpr uint8_t Count = LastPort<Mask> - First + 1;
+    uint8_t Buffer[2] = {0};
+
+    if constexpr (Count == 1 || Info.AutoIncrement)
+    {
+      uint8_t Address = RegAddress(Reg, First);
+
+      if (Bus::Send(AddressI2C, &Address, 1) < 0 ||
+          Bus::Receive(AddressI2C, Buffer, Count) < 0)
+        return PCA9534_FAIL;
+    }
+    else
+    {
+      for (uint8_t Port = First; Port < First + Count; Port++)
+      {
+        uint8_t Address = RegAddress(Reg, Port);
+
+        if (Bus::Send(AddressI2C, &Address, 1) < 0 ||
+            Bus::Receive(AddressI2C, &Buffer[Port - First], 1) < 0)
+          return PCA9534_FAIL;
+      }
+    }
+
+    Value = (uint16_t)(((Buffer[0] | ((uint16_t)Buffer[1] << 8)) << (First * 8)));
+    return PCA9534_OK;
+  }
+
+  // Merge Value into the Mask bits of a shadow register and write it
+  template <uint8_t Reg, uint16_t Mask>
+  PCA9534_Result_t
+  Update(uint16_t &Shadow, uint16_t Value)
+  {
+    uint16_t Data = (uint16_t)((Shadow & ~Mask) | (Value & Mask));
+
+    if (WriteReg<Reg, Mask>(Data) != PCA9534_OK)
+      return PCA9534_FAIL;
+
+    Shadow = Data;
+    return PCA9534_OK;
+  }
+
+  // Shadow copy of registers (port 0 in the low byte)
+  uint16_t RegOutput = PinMask;
+  uint16_t RegPolarity = 0;
+  uint16_t RegConfig = PinMask;
+  uint16_t RegPullEnable = 0;
+  uint16_t RegPullSelect = PinMask;
+};
+
+} // namespace PCA9534
+
+#endif //! _PCA9534_HPP_
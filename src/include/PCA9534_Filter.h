@@ -0,0 +1,173 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Filter.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Input debounce and glitch filter for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_FILTER_H_
+#define _PCA9534_FILTER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Maximum number of consecutive samples of a debounce filter
+ */
+#define PCA9534_FILTER_SAMPLES_MAX  15
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Debounce filter data type
+ * @note   The counters are vertical: bit n of Count[i] is bit i of the counter
+ *         of pin n, so all 8 pins are processed with a few bitwise operations.
+ *         A pin changes its debounced state after it differs from it in
+ *         Samples consecutive (optionally majority-voted) samples.
+ */
+typedef struct PCA9534_Filter_s
+{
+  // Debounced state of pins
+  uint8_t State;
+
+  // Vertical counters of consecutive samples different from State
+  uint8_t Count[4];
+
+  // Vertical per-pin sample counts
+  uint8_t Samples[4];
+
+  // Pins that use majority vote of the last 3 raw samples
+  uint8_t MajorityMask;
+
+  // Last 2 raw samples
+  uint8_t History[2];
+} PCA9534_Filter_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the filter
+ * @note   All pins use 1 sample (no filtering) and no majority vote.
+ * @param  Filter: Pointer to filter
+ * @param  State: Initial state of pins
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_Init(PCA9534_Filter_t *Filter, uint8_t State);
+
+
+/**
+ * @brief  Set the number of consecutive samples needed to accept a change
+ * @param  Filter: Pointer to filter
+ * @param  Mask: Mask of pins
+ * @param  Samples: Number of samples (1 <= Samples <= PCA9534_FILTER_SAMPLES_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_SetSamples(PCA9534_Filter_t *Filter, uint8_t Mask,
+                          uint8_t Samples);
+
+
+/**
+ * @brief  Enable majority vote of the last 3 raw samples for pins
+ * @note   The majority vote removes one-sample glitches before debouncing.
+ * @param  Filter: Pointer to filter
+ * @param  Mask: Mask of pins that use majority vote
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_SetMajority(PCA9534_Filter_t *Filter, uint8_t Mask);
+
+
+/**
+ * @brief  Feed one raw sample into the filter
+ * @param  Filter: Pointer to filter
+ * @param  Sample: Raw state of pins
+ * @retval Mask of pins whose debounced state changed
+ */
+uint8_t
+PCA9534_Filter_Update(PCA9534_Filter_t *Filter, uint8_t Sample);
+
+
+/**
+ * @brief  Feed one raw sample of many devices into their filters
+ * @note   Use it after a sweep that reads many devices into an array.
+ * @param  Filters: Pointer to array of filters
+ * @param  Samples: Pointer to array of raw samples
+ * @param  Changed: Pointer to array of changed masks (can be NULL)
+ * @param  Count: Number of devices
+ * @retval None
+ */
+void
+PCA9534_Filter_UpdateMany(PCA9534_Filter_t *Filters, const uint8_t *Samples,
+                          uint8_t *Changed, uint32_t Count);
+
+
+/**
+ * @brief  Read data from the device and filter it
+ * @param  Handler: Pointer to handler
+ * @param  Filter: Pointer to filter
+ * @param  Data: Pointer to debounced data
+ * @param  Changed: Pointer to mask of pins whose debounced state changed
+ *                  (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Filter_Read(PCA9534_Handler_t *Handler, PCA9534_Filter_t *Filter,
+                    uint8_t *Data, uint8_t *Changed);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_FILTER_H_
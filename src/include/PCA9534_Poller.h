@@ -0,0 +1,228 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Poller.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Adaptive input polling for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_POLLER_H_
+#define _PCA9534_POLLER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Window of measured poll rates in microseconds
+ */
+#ifndef PCA9534_POLLER_RATE_WINDOW
+#define PCA9534_POLLER_RATE_WINDOW  1000000
+#endif
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Function type for input change notification
+ * @param  Index: Index of device in the poller
+ * @param  Data: New input value
+ * @param  Changed: Mask of changed pins
+ */
+typedef void (*PCA9534_Poller_Change_t)(uint16_t Index, uint8_t Data,
+                                        uint8_t Changed);
+
+/**
+ * @brief  Polled device data type
+ * @note   Times are in microseconds and may wrap around.
+ */
+typedef struct PCA9534_PollerDevice_s
+{
+  PCA9534_Handler_t *Handler;
+
+  // Poll period bounds
+  uint32_t MinPeriod;
+  uint32_t MaxPeriod;
+
+  // Current poll period and time of next poll
+  uint32_t Period;
+  uint32_t Next;
+
+  // Last input value
+  uint8_t Last;
+
+  // Number of polls and of polls that saw a change
+  uint32_t Polls;
+  uint32_t Changes;
+  // Measured rate: start and polls of the current window and rate in mHz
+  // of the last complete window
+  uint32_t WindowStart;
+  uint32_t WindowPolls;
+  uint32_t Rate;
+} PCA9534_PollerDevice_t;
+
+/**
+ * @brief  Poller data type
+ */
+typedef struct PCA9534_Poller_s
+{
+  PCA9534_PollerDevice_t *Devices;
+  uint16_t Count;
+
+  // Global bus budget in polls per second (0: unlimited)
+  uint32_t Budget;
+  // Budget credit in polls x 1000000
+  uint64_t Credit;
+  uint32_t LastRefill;
+
+  PCA9534_Poller_Change_t Change;
+} PCA9534_Poller_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the poller
+ * @param  Poller: Pointer to poller
+ * @param  Devices: Pointer to array of devices
+ * @param  Count: Number of devices
+ * @param  Budget: Global bus budget in polls per second (0: unlimited)
+ * @param  Change: Function called when an input changes (can be NULL)
+ * @param  Now: Current time in microseconds
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_Init(PCA9534_Poller_t *Poller, PCA9534_PollerDevice_t *Devices,
+                    uint16_t Count, uint32_t Budget,
+                    PCA9534_Poller_Change_t Change, uint32_t Now);
+
+
+/**
+ * @brief  Set a device of the poller
+ * @note   The device starts at MinPeriod and its last input value at 0, so
+ *         the first poll reports the pins that are high.
+ * @param  Poller: Pointer to poller
+ * @param  Index: Index of device
+ * @param  Handler: Pointer to initialized handler
+ * @param  MinPeriod: Minimum poll period in microseconds (1 <= MinPeriod)
+ * @param  MaxPeriod: Maximum poll period in microseconds
+ *         (MinPeriod <= MaxPeriod <= 0x7FFFFFFF)
+ * @param  Now: Current time in microseconds
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_SetDevice(PCA9534_Poller_t *Poller, uint16_t Index,
+                         PCA9534_Handler_t *Handler, uint32_t MinPeriod,
+                         uint32_t MaxPeriod, uint32_t Now);
+
+
+/**
+ * @brief  Poll the devices that are due
+ * @note   Due devices are read most overdue first while the bus budget
+ *         allows. A change halves the poll period of the device and a quiet
+ *         poll doubles it, within its bounds.
+ * @param  Poller: Pointer to poller
+ * @param  Now: Current time in microseconds
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read at least one device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_Poll(PCA9534_Poller_t *Poller, uint32_t Now);
+
+
+/**
+ * @brief  Time until the next device is due
+ * @note   When the bus budget has no credit for a poll, it is the later of
+ *         the next due time and the time the credit is refilled, so a caller
+ *         that sleeps for it does not wake up to a poll that does nothing.
+ * @param  Poller: Pointer to poller
+ * @param  Now: Current time in microseconds
+ * @retval Time in microseconds (0 if a device is already due)
+ */
+uint32_t
+PCA9534_Poller_NextDue(PCA9534_Poller_t *Poller, uint32_t Now);
+
+
+/**
+ * @brief  Target poll rate of a device (1 / current poll period)
+ * @note   The bus budget may keep the measured rate below it; see
+ *         PCA9534_Poller_GetRate.
+ * @param  Poller: Pointer to poller
+ * @param  Index: Index of device
+ * @param  MilliHz: Pointer to poll rate in mHz
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_GetTargetRate(PCA9534_Poller_t *Poller, uint16_t Index,
+                             uint32_t *MilliHz);
+
+
+/**
+ * @brief  Measured poll rate of a device
+ * @note   Completed polls are counted over windows of
+ *         PCA9534_POLLER_RATE_WINDOW, so the rate shows the throttling of
+ *         the bus budget. It is the rate of the last complete window, or of
+ *         the current one if it is already longer than a window (a starved
+ *         device) or no window is complete yet.
+ * @param  Poller: Pointer to poller
+ * @param  Index: Index of device
+ * @param  Now: Current time in microseconds
+ * @param  MilliHz: Pointer to poll rate in mHz
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Poller_GetRate(PCA9534_Poller_t *Poller, uint16_t Index, uint32_t Now,
+                       uint32_t *MilliHz);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_POLLER_H_
@@ -0,0 +1,155 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Scan.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Bus scan and device type detection for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_SCAN_H_
+#define _PCA9534_SCAN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Function type for selecting a channel of an I2C multiplexer
+ * @param  Channel: Channel number
+ * @retval
+ *         -  0: The operation was successful.
+ *         - -1: The operation failed.
+ */
+typedef int8_t (*PCA9534_Scan_Select_t)(uint8_t Channel);
+
+/**
+ * @brief  Found device data type
+ */
+typedef struct PCA9534_ScanResult_s
+{
+  // Multiplexer channel (0 without multiplexer)
+  uint8_t Channel;
+
+  // I2C Address
+  uint8_t AddressI2C;
+
+  // Detected device type
+  PCA9534_Device_t Device;
+
+  // Device type could not be confirmed (see PCA9534_Detect)
+  uint8_t Ambiguous;
+} PCA9534_ScanResult_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Detect the type of a device
+ * @note   Only register pointers are written and no register is changed. The
+ *         parts are told apart by the registers they have: a command byte
+ *         that is not acknowledged means the register is missing, and one
+ *         that is acknowledged is confirmed by reading the registers back
+ *         (parts that alias the command byte return the same contents as the
+ *         basic registers). Drop-in compatible parts can not be told apart,
+ *         so the result is the first part of the family: PCA9534, PCA9534A,
+ *         PCA9535, PCAL9534 or PCAL9535.
+ * @note   If the read back can not decide (the compared registers hold the
+ *         same values), the smaller part is reported and Ambiguous is set.
+ *         A part that aliases the command bytes always ends here, since it
+ *         can not be told from a larger part whose extra registers hold the
+ *         same values. The type must then be given by the application.
+ * @param  Platform: Pointer to platform dependent layer (bus initialized)
+ * @param  AddressI2C: I2C Address
+ * @param  Device: Pointer to device type
+ * @param  Ambiguous: Pointer to ambiguous flag (can be NULL)
+ *         - 0: Device type is confirmed.
+ *         - 1: Device type could not be confirmed.
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: No device answers or failed to read back.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Detect(const PCA9534_Platform_t *Platform, uint8_t AddressI2C,
+               PCA9534_Device_t *Device, uint8_t *Ambiguous);
+
+
+/**
+ * @brief  Scan a bus for devices
+ * @note   The address windows 0x20-0x27 and 0x38-0x3F are probed on every
+ *         multiplexer channel. The scan keeps no state, so the buses of a
+ *         system can be scanned in parallel (one task per bus).
+ * @note   If Handlers is not NULL, each found device gets a handler with a
+ *         copy of Platform without Init, since the bus is already
+ *         initialized. Devices with an ambiguous type get no handler
+ *         (its Part is NULL). By default the handler is filled by reading the
+ *         registers back (PCA9534_InitFromDevice), so a device that is already
+ *         driving its pins is left untouched. With Reset the device is
+ *         initialized with PCA9534_Init instead, which writes the power-on
+ *         defaults. With a multiplexer the application must select Channel
+ *         before using it.
+ * @param  Platform: Pointer to platform dependent layer (bus initialized)
+ * @param  Select: Function to select a multiplexer channel (can be NULL)
+ * @param  Channels: Number of multiplexer channels (ignored if Select is NULL)
+ * @param  Results: Pointer to array of found devices
+ * @param  Handlers: Pointer to array of handlers (can be NULL)
+ * @param  Reset: Write the power-on defaults to found devices (ignored if
+ *                Handlers is NULL)
+ *         - 0: Read the registers back, no register is changed.
+ *         - 1: Reset the registers with PCA9534_Init.
+ * @param  Max: Number of elements of Results and Handlers
+ * @param  Count: Pointer to number of found devices
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to select a channel or to initialize a
+ *                         handler, or more than Max devices were found.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Scan(const PCA9534_Platform_t *Platform, PCA9534_Scan_Select_t Select,
+             uint8_t Channels, PCA9534_ScanResult_t *Results,
+             PCA9534_Handler_t *Handlers, uint8_t Reset, uint8_t Max,
+             uint8_t *Count);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_SCAN_H_
@@ -0,0 +1,148 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_SharedInt.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Shared interrupt line dispatcher for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_SHAREDINT_H_
+#define _PCA9534_SHAREDINT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Maximum number of devices on a shared interrupt line
+ */
+#define PCA9534_SHAREDINT_DEVICES_MAX 16
+
+/**
+ * @brief  Maximum number of sweeps of the group per interrupt
+ * @note   A new change during a sweep keeps the line asserted, so the group is
+ *         swept again. The limit protects against a stuck line.
+ */
+#define PCA9534_SHAREDINT_PASSES_MAX  2
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Function type for reading the level of the shared interrupt line
+ * @retval 1 if the line is asserted, 0 otherwise
+ */
+typedef uint8_t (*PCA9534_SharedInt_Level_t)(void);
+
+/**
+ * @brief  Function type for input change notification
+ * @param  Index: Index of device in the group
+ * @param  Data: New input value
+ * @param  Changed: Mask of changed pins
+ */
+typedef void (*PCA9534_SharedInt_Change_t)(uint8_t Index, uint8_t Data,
+                                           uint8_t Changed);
+
+/**
+ * @brief  Shared interrupt group data type
+ * @note   Reading the input port of a PCA9534 clears its interrupt, so the
+ *         devices are read most recently active first and the sweep stops as
+ *         soon as the line deasserts.
+ */
+typedef struct PCA9534_SharedInt_s
+{
+  PCA9534_Handler_t **Handlers;
+  uint8_t Count;
+
+  // Read order of devices (most recently active first)
+  uint8_t Order[PCA9534_SHAREDINT_DEVICES_MAX];
+
+  // Last input value of devices
+  uint8_t Last[PCA9534_SHAREDINT_DEVICES_MAX];
+
+  PCA9534_SharedInt_Level_t Level;
+  PCA9534_SharedInt_Change_t Change;
+
+  // Number of handled interrupts and of reads done for them
+  uint32_t Interrupts;
+  uint32_t Reads;
+} PCA9534_SharedInt_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a shared interrupt group
+ * @note   All devices are read once to get their input values and to clear
+ *         pending interrupts.
+ * @param  Group: Pointer to group
+ * @param  Handlers: Pointer to array of initialized handlers
+ * @param  Count: Number of devices (1 <= Count <= PCA9534_SHAREDINT_DEVICES_MAX)
+ * @param  Level: Function to read the level of the interrupt line
+ * @param  Change: Function called when an input changes (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read a device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SharedInt_Init(PCA9534_SharedInt_t *Group, PCA9534_Handler_t **Handlers,
+                       uint8_t Count, PCA9534_SharedInt_Level_t Level,
+                       PCA9534_SharedInt_Change_t Change);
+
+
+/**
+ * @brief  Handle an interrupt of the shared line
+ * @note   Call it from task context after the line was asserted.
+ * @param  Group: Pointer to group
+ * @param  Reads: Pointer to number of devices read (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read a device or the line stays asserted.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_SharedInt_Handle(PCA9534_SharedInt_t *Group, uint8_t *Reads);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_SHAREDINT_H_
@@ -0,0 +1,239 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Subscribe.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Per-pin change subscription for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_SUBSCRIBE_H_
+#define _PCA9534_SUBSCRIBE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  End of a subscription list
+ */
+#define PCA9534_SUBSCRIBE_NONE  0xFFFF
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Edge data type
+ */
+typedef enum PCA9534_Edge_e
+{
+  PCA9534_EDGE_RISING   = 1,
+  PCA9534_EDGE_FALLING  = 2,
+  PCA9534_EDGE_BOTH     = 3
+} PCA9534_Edge_t;
+
+/**
+ * @brief  Function type for pin change notification
+ * @param  Device: Index of device
+ * @param  Pin: Pin number (0 <= Pin <= 7)
+ * @param  Level: New level of pin
+ * @param  Context: Context of subscription
+ */
+typedef void (*PCA9534_Subscribe_Callback_t)(uint8_t Device, uint8_t Pin,
+                                             uint8_t Level, void *Context);
+
+/**
+ * @brief  Subscription data type
+ */
+typedef struct PCA9534_Subscription_s
+{
+  PCA9534_Subscribe_Callback_t Callback;
+  void *Context;
+
+  uint8_t Device;
+  uint8_t Pin;
+  uint8_t Edge;
+
+  // Next subscription of the same pin or of the free list
+  uint16_t Next;
+} PCA9534_Subscription_t;
+
+/**
+ * @brief  Subscribed device data type
+ */
+typedef struct PCA9534_SubscribeDevice_s
+{
+  // First subscription of each pin
+  uint16_t Head[8];
+
+  // Pins with rising and falling edge subscribers
+  uint8_t RisingMask;
+  uint8_t FallingMask;
+
+  // Last input value
+  uint8_t Last;
+} PCA9534_SubscribeDevice_t;
+
+/**
+ * @brief  Subscription table data type
+ * @note   Subscriptions are kept in one list per pin, so a sample only visits
+ *         the subscribers of the pins that changed.
+ */
+typedef struct PCA9534_Subscribe_s
+{
+  PCA9534_SubscribeDevice_t *Devices;
+  uint8_t DeviceCount;
+
+  PCA9534_Subscription_t *Table;
+  uint16_t TableSize;
+
+  // First unused subscription
+  uint16_t Free;
+  // Next subscription to visit while dispatching
+  uint16_t Cursor;
+} PCA9534_Subscribe_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the subscription table
+ * @note   The last input value of all devices starts at 0.
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Devices: Pointer to array of devices
+ * @param  DeviceCount: Number of devices
+ * @param  Table: Pointer to array of subscriptions
+ * @param  TableSize: Number of subscriptions (TableSize < PCA9534_SUBSCRIBE_NONE)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Init(PCA9534_Subscribe_t *Subscribe,
+                       PCA9534_SubscribeDevice_t *Devices, uint8_t DeviceCount,
+                       PCA9534_Subscription_t *Table, uint16_t TableSize);
+
+
+/**
+ * @brief  Add a subscription
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Pin: Pin number (0 <= Pin <= 7)
+ * @param  Edge: Edge to be notified about
+ * @param  Callback: Function called on the edge
+ * @param  Context: Context passed to Callback
+ * @param  Id: Pointer to ID of subscription (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: The table is full.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Add(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                      uint8_t Pin, PCA9534_Edge_t Edge,
+                      PCA9534_Subscribe_Callback_t Callback, void *Context,
+                      uint16_t *Id);
+
+
+/**
+ * @brief  Remove a subscription
+ * @note   It can be called from a callback during a dispatch.
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Id: ID of subscription
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Remove(PCA9534_Subscribe_t *Subscribe, uint16_t Id);
+
+
+/**
+ * @brief  Set the last input value of a device without notification
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Data: Input value
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_SetLast(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                          uint8_t Data);
+
+
+/**
+ * @brief  Notify the subscribers of the pins changed by a new sample
+ * @note   The changed mask is computed once and only its set bits with
+ *         subscribers for the edge are visited.
+ * @note   A callback may add subscriptions and remove any subscription,
+ *         including its own. A subscription added by a callback is notified
+ *         of this change only if its pin has not been visited yet. Dispatch
+ *         and Read must not be called from a callback.
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Data: New input value
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Dispatch(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                           uint8_t Data);
+
+
+/**
+ * @brief  Read the input port of a device and notify the subscribers
+ * @param  Subscribe: Pointer to subscription table
+ * @param  Device: Index of device
+ * @param  Handler: Pointer to handler of device
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read the device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Subscribe_Read(PCA9534_Subscribe_t *Subscribe, uint8_t Device,
+                       PCA9534_Handler_t *Handler);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_SUBSCRIBE_H_
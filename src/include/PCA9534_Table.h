@@ -0,0 +1,263 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Table.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Struct-of-arrays device table for large PCA9534 installations
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_TABLE_H_
+#define _PCA9534_TABLE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Use SSE2/AVX2 kernels when the compiler targets them
+ * @note   Set it to 0 to force the portable kernel.
+ */
+#ifndef PCA9534_TABLE_SIMD
+#define PCA9534_TABLE_SIMD        1
+#endif
+
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  The per-device arrays are padded to a multiple of this many devices
+ */
+#define PCA9534_TABLE_ALIGN       32
+
+/**
+ * @brief  Health value of a device that failed this many sweeps in a row
+ *         (saturated)
+ */
+#define PCA9534_TABLE_HEALTH_MAX  255
+
+
+
+/* Exported Macros --------------------------------------------------------------*/
+/**
+ * @brief  Padded number of devices of a table
+ * @param  CAPACITY: Maximum number of devices
+ */
+#define PCA9534_TABLE_PADDED(CAPACITY) \
+  ((((CAPACITY) + PCA9534_TABLE_ALIGN - 1) / PCA9534_TABLE_ALIGN) * \
+   PCA9534_TABLE_ALIGN)
+
+/**
+ * @brief  Size of the storage of a table in bytes
+ * @note   4 bytes of time and 8 bytes of state per device.
+ * @param  CAPACITY: Maximum number of devices
+ */
+#define PCA9534_TABLE_STORAGE(CAPACITY) \
+  (PCA9534_TABLE_PADDED(CAPACITY) * (sizeof(uint32_t) + 8))
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Device table data type
+ * @note   The table holds 8-bit devices (1 port) in struct-of-arrays form:
+ *         each field is a contiguous array indexed by device ID, so group
+ *         operations are linear loops over a few small arrays instead of a
+ *         walk over handlers with function pointers and padding.
+ */
+typedef struct PCA9534_Table_s
+{
+  // Platform dependent layer of each bus (indexed by bus ID)
+  const PCA9534_Platform_t *Buses;
+  uint8_t BusCount;
+
+  // Maximum and current number of devices
+  uint16_t Capacity;
+  uint16_t Count;
+
+  // I2C Address and bus ID
+  uint8_t *AddressI2C;
+  uint8_t *Bus;
+
+  // Shadow copy of Output, Polarity Inversion and Configuration registers
+  uint8_t *Output;
+  uint8_t *Polarity;
+  uint8_t *Config;
+
+  // Input values of the last two sweeps
+  uint8_t *Input;
+  uint8_t *Previous;
+
+  // Sweeps failed in a row (0: healthy)
+  uint8_t *Health;
+
+  // Time of the last successful read
+  uint32_t *Time;
+} PCA9534_Table_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a device table
+ * @param  Table: Pointer to table
+ * @param  Buses: Pointer to array of platform dependent layers (buses
+ *                initialized, Send and Receive linked)
+ * @param  BusCount: Number of buses
+ * @param  Storage: Pointer to 4-byte aligned storage of
+ *                  PCA9534_TABLE_STORAGE(Capacity) bytes
+ * @param  Capacity: Maximum number of devices
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Init(PCA9534_Table_t *Table, const PCA9534_Platform_t *Buses,
+                   uint8_t BusCount, void *Storage, uint16_t Capacity);
+
+
+/**
+ * @brief  Add a device to the table
+ * @note   Nothing is sent to the device. Its shadows start at the power-on
+ *         defaults.
+ * @param  Table: Pointer to table
+ * @param  Bus: Bus ID
+ * @param  AddressI2C: I2C Address
+ * @param  Id: Pointer to device ID (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: The table is full.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Add(PCA9534_Table_t *Table, uint8_t Bus, uint8_t AddressI2C,
+                  uint16_t *Id);
+
+
+/**
+ * @brief  Set direction of pins of a device
+ * @param  Table: Pointer to table
+ * @param  Id: Device ID
+ * @param  Dir: Direction of pins (1: Output, 0: Input)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_SetDir(PCA9534_Table_t *Table, uint16_t Id, uint8_t Dir);
+
+
+/**
+ * @brief  Write data to a device
+ * @param  Table: Pointer to table
+ * @param  Id: Device ID
+ * @param  Data: Data to write
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Write(PCA9534_Table_t *Table, uint16_t Id, uint8_t Data);
+
+
+/**
+ * @brief  Read the inputs of a range of devices
+ * @note   The current inputs are moved to Previous first. A failed device
+ *         keeps its input and its Health is incremented.
+ * @param  Table: Pointer to table
+ * @param  First: ID of first device
+ * @param  Count: Number of devices
+ * @param  Now: Current time
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read at least one device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Sweep(PCA9534_Table_t *Table, uint16_t First, uint16_t Count,
+                    uint32_t Now);
+
+
+/**
+ * @brief  Find the devices of a range whose inputs changed in the last sweep
+ * @note   Use the same range as the sweep: Previous is only updated for the
+ *         swept devices, so the changes of other devices would be reported
+ *         again.
+ * @note   Blocks of 32 devices are compared at once (compare/movemask) and
+ *         only the set bits of the resulting change mask are visited.
+ * @param  Table: Pointer to table
+ * @param  First: ID of first device
+ * @param  Count: Number of devices
+ * @param  Ids: Pointer to array of changed device IDs (Count elements)
+ * @param  Masks: Pointer to array of changed pins (Count elements)
+ * @param  Changed: Pointer to number of changed devices
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Diff(PCA9534_Table_t *Table, uint16_t First, uint16_t Count,
+                   uint16_t *Ids, uint8_t *Masks, uint16_t *Changed);
+
+
+/**
+ * @brief  Check a range of devices for reset and restore them
+ * @note   The Configuration register of each device is read back. On
+ *         mismatch Output, Polarity Inversion and Configuration are
+ *         rewritten from the shadows.
+ * @param  Table: Pointer to table
+ * @param  First: ID of first device
+ * @param  Count: Number of devices
+ * @param  Restored: Pointer to number of restored devices (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Table_Scrub(PCA9534_Table_t *Table, uint16_t First, uint16_t Count,
+                    uint16_t *Restored);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_TABLE_H_
@@ -0,0 +1,163 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_Transaction.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Atomic multi-device output commit for PCA9534 driver
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_TRANSACTION_H_
+#define _PCA9534_TRANSACTION_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Maximum number of devices of a transaction
+ */
+#define PCA9534_TRANSACTION_DEVICES_MAX 16
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Output transaction data type
+ * @note   Pin changes are staged as a mask and values per device and merged
+ *         into the output shadows by the commit, so outputs changed outside
+ *         the transaction after Begin are kept. The devices are written
+ *         back-to-back, in the order of Handlers, with all data prepared in
+ *         advance.
+ */
+typedef struct PCA9534_Transaction_s
+{
+  PCA9534_Handler_t **Handlers;
+  uint8_t Count;
+
+  // Transaction is open
+  uint8_t Open;
+
+  // Staged pins and their output values
+  uint16_t Mask[PCA9534_TRANSACTION_DEVICES_MAX];
+  uint16_t Value[PCA9534_TRANSACTION_DEVICES_MAX];
+} PCA9534_Transaction_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a transaction object
+ * @param  Transaction: Pointer to transaction
+ * @param  Handlers: Pointer to array of pointers to initialized handlers (in
+ *                   order of writing)
+ * @param  Count: Number of devices
+ *         (1 <= Count <= PCA9534_TRANSACTION_DEVICES_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Init(PCA9534_Transaction_t *Transaction,
+                         PCA9534_Handler_t **Handlers, uint8_t Count);
+
+
+/**
+ * @brief  Begin a transaction
+ * @param  Transaction: Pointer to transaction
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Begin(PCA9534_Transaction_t *Transaction);
+
+
+/**
+ * @brief  Stage output values of pins of one device
+ * @param  Transaction: Pointer to transaction
+ * @param  Device: Index of device
+ * @param  Mask: Mask of pins to change
+ * @param  Value: Values of pins (1: High, 0: Low)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or no
+ *                                  transaction is open.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Stage(PCA9534_Transaction_t *Transaction, uint8_t Device,
+                          uint16_t Mask, uint16_t Value);
+
+
+/**
+ * @brief  Commit the staged values
+ * @note   The staged pins are merged into the current output shadows, so
+ *         only they are changed. Only the devices whose outputs change are
+ *         written, one transfer each. The skew is measured with GetTime of
+ *         the first handler, from the end of the first write to the end of
+ *         the last one.
+ * @param  Transaction: Pointer to transaction
+ * @param  Skew: Pointer to skew between devices in microseconds (can be NULL,
+ *               0 if GetTime is not linked or at most one device is written)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send data (the devices before the failed
+ *                         one are already written).
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or no
+ *                                  transaction is open.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Commit(PCA9534_Transaction_t *Transaction, uint32_t *Skew);
+
+
+/**
+ * @brief  Drop the staged values
+ * @param  Transaction: Pointer to transaction
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transaction_Abort(PCA9534_Transaction_t *Transaction);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_TRANSACTION_H_
@@ -0,0 +1,192 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_WidePort.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Virtual wide port over multiple PCA9534 devices
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_WIDEPORT_H_
+#define _PCA9534_WIDEPORT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "PCA9534.h"
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Use BMI2 pext/pdep instructions when the compiler targets them
+ * @note   Set it to 0 to force the portable bit loops.
+ */
+#ifndef PCA9534_WIDEPORT_BMI2
+#define PCA9534_WIDEPORT_BMI2         1
+#endif
+
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Maximum number of devices of a wide port
+ */
+#define PCA9534_WIDEPORT_DEVICES_MAX  16
+
+/**
+ * @brief  Maximum number of bits of a wide port
+ */
+#define PCA9534_WIDEPORT_BITS_MAX     64
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Location of a bit of a wide port
+ */
+typedef struct PCA9534_WidePin_s
+{
+  // Index of device in the wide port
+  uint8_t Device;
+
+  // Pin number (0 <= Pin <= 7, 15 for 16-bit devices)
+  uint8_t Pin;
+} PCA9534_WidePin_t;
+
+/**
+ * @brief  Wide port data type
+ * @note   The mapping is compiled to a pair of masks per device: the bits of
+ *         the wide port and the pins they are mapped to. If the bits and pins
+ *         are in the same order, scatter and gather are one pdep/pext pair.
+ */
+typedef struct PCA9534_WidePort_s
+{
+  PCA9534_Handler_t **Handlers;
+  uint8_t DeviceCount;
+
+  // Number of bits
+  uint8_t Width;
+
+  // Bits of the wide port mapped to each device
+  uint64_t BitMask[PCA9534_WIDEPORT_DEVICES_MAX];
+  // Pins of each device mapped to the wide port
+  uint16_t PinMask[PCA9534_WIDEPORT_DEVICES_MAX];
+  // Bits and pins of device are in the same order
+  uint8_t Ordered[PCA9534_WIDEPORT_DEVICES_MAX];
+
+  // Location of each bit
+  PCA9534_WidePin_t Map[PCA9534_WIDEPORT_BITS_MAX];
+} PCA9534_WidePort_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a wide port and compile its mapping
+ * @param  Port: Pointer to wide port
+ * @param  Handlers: Pointer to array of pointers to initialized handlers
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_WIDEPORT_DEVICES_MAX)
+ * @param  Map: Pointer to location of each bit (bit 0 first)
+ * @param  Width: Number of bits (1 <= Width <= PCA9534_WIDEPORT_BITS_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or two bits
+ *                                  are mapped to the same pin.
+ */
+PCA9534_Result_t
+PCA9534_WidePort_Init(PCA9534_WidePort_t *Port, PCA9534_Handler_t **Handlers,
+                      uint8_t DeviceCount, const PCA9534_WidePin_t *Map,
+                      uint8_t Width);
+
+
+/**
+ * @brief  Write the wide port
+ * @note   Only the devices whose output pins change are written, one
+ *         transfer each. Unmapped pins keep their output values.
+ * @param  Port: Pointer to wide port
+ * @param  Data: Data to write
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_WidePort_Write(PCA9534_WidePort_t *Port, uint64_t Data);
+
+
+/**
+ * @brief  Read the wide port
+ * @note   The devices are read in one sweep, one transfer each.
+ * @param  Port: Pointer to wide port
+ * @param  Data: Pointer to data
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to send or receive data.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_WidePort_Read(PCA9534_WidePort_t *Port, uint64_t *Data);
+
+
+/**
+ * @brief  Scatter a wide port value to the pins of one device
+ * @param  Port: Pointer to wide port
+ * @param  Device: Index of device
+ * @param  Data: Wide port value
+ * @retval Pin values of device (unmapped pins are 0)
+ */
+uint16_t
+PCA9534_WidePort_Scatter(const PCA9534_WidePort_t *Port, uint8_t Device,
+                         uint64_t Data);
+
+
+/**
+ * @brief  Gather the pins of one device into a wide port value
+ * @param  Port: Pointer to wide port
+ * @param  Device: Index of device
+ * @param  Pins: Pin values of device
+ * @retval Wide port value (bits of other devices are 0)
+ */
+uint64_t
+PCA9534_WidePort_Gather(const PCA9534_WidePort_t *Port, uint8_t Device,
+                        uint16_t Pins);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_WIDEPORT_H_
@@ -0,0 +1,381 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_capture.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Continuous input capture into a memory-mapped ring file
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include "PCA9534_capture.h"
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Number of samples between two updates of the measured rate
+#define PCA9534_CAPTURE_RATE_PERIOD   1024
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint64_t
+Capture_Now(clockid_t Clock)
+{
+  struct timespec Ts;
+
+  clock_gettime(Clock, &Ts);
+  return (uint64_t)Ts.tv_sec * 1000000000ull + (uint64_t)Ts.tv_nsec;
+}
+
+
+static uint16_t
+Capture_RecordSize(uint16_t DeviceCount)
+{
+  return (uint16_t)(sizeof(uint64_t) + ((DeviceCount + 7u) & ~7u));
+}
+
+
+static uint8_t *
+Capture_Record(const PCA9534_Capture_t *Capture, uint64_t Slot)
+{
+  return Capture->Map + PCA9534_CAPTURE_HEADER_SIZE +
+         Slot * Capture->Header->RecordSize;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Create a capture file and map it
+ * @note   The whole file is allocated here, so sampling does not allocate or
+ *         call the kernel (timestamps come from the vDSO clock).
+ * @param  Capture: Pointer to capture session
+ * @param  Path: Path of capture file
+ * @param  Handlers: Array of pointers to initialized handlers
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @param  Capacity: Number of records of the ring
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to create or map the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Create(PCA9534_Capture_t *Capture, const char *Path,
+                       PCA9534_Handler_t **Handlers, uint16_t DeviceCount,
+                       uint64_t Capacity)
+{
+  PCA9534_CaptureHeader_t *Header = NULL;
+  uint16_t RecordSize = 0;
+  uint16_t i = 0;
+
+  if (!Capture || !Path || !Handlers || !Capacity)
+    return PCA9534_INVALID_PARAM;
+
+  if (!DeviceCount || DeviceCount > PCA9534_CAPTURE_DEVICES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < DeviceCount; i++)
+  {
+    if (!Handlers[i])
+      return PCA9534_INVALID_PARAM;
+  }
+
+  // The map size must fit in size_t
+  RecordSize = Capture_RecordSize(DeviceCount);
+  if (Capacity > (SIZE_MAX - PCA9534_CAPTURE_HEADER_SIZE) / RecordSize)
+    return PCA9534_INVALID_PARAM;
+
+  memset(Capture, 0, sizeof(PCA9534_Capture_t));
+  Capture->MapSize = PCA9534_CAPTURE_HEADER_SIZE +
+                     (size_t)Capacity * RecordSize;
+
+  Capture->Fd = open(Path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (Capture->Fd < 0)
+    return PCA9534_FAIL;
+
+  if (ftruncate(Capture->Fd, (off_t)Capture->MapSize) != 0)
+  {
+    close(Capture->Fd);
+    return PCA9534_FAIL;
+  }
+
+  Capture->Map = mmap(NULL, Capture->MapSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, Capture->Fd, 0);
+  if (Capture->Map == MAP_FAILED)
+  {
+    close(Capture->Fd);
+    Capture->Map = NULL;
+    return PCA9534_FAIL;
+  }
+
+  Header = (PCA9534_CaptureHeader_t *)Capture->Map;
+  Header->Magic = PCA9534_CAPTURE_MAGIC;
+  Header->Version = PCA9534_CAPTURE_VERSION;
+  Header->RecordSize = RecordSize;
+  Header->Capacity = Capacity;
+  Header->Written = 0;
+  Header->StartRealtime = Capture_Now(CLOCK_REALTIME);
+  Header->StartMonotonic = Capture_Now(CLOCK_MONOTONIC);
+  Header->RateMilliHz = 0;
+  Header->Failures = 0;
+  Header->DeviceCount = DeviceCount;
+  for (i = 0; i < DeviceCount; i++)
+    Header->Devices[i] = Handlers[i]->AddressI2C;
+
+  Capture->Header = Header;
+  Capture->Handlers = Handlers;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Map an existing capture file read-only
+ * @param  Capture: Pointer to capture session
+ * @param  Path: Path of capture file
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to open the file or the file is invalid.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Open(PCA9534_Capture_t *Capture, const char *Path)
+{
+  const PCA9534_CaptureHeader_t *Header = NULL;
+  struct stat St;
+
+  if (!Capture || !Path)
+    return PCA9534_INVALID_PARAM;
+
+  memset(Capture, 0, sizeof(PCA9534_Capture_t));
+  Capture->Fd = open(Path, O_RDONLY);
+  if (Capture->Fd < 0)
+    return PCA9534_FAIL;
+
+  if (fstat(Capture->Fd, &St) != 0 ||
+      (size_t)St.st_size < PCA9534_CAPTURE_HEADER_SIZE)
+  {
+    close(Capture->Fd);
+    return PCA9534_FAIL;
+  }
+
+  Capture->MapSize = (size_t)St.st_size;
+  Capture->Map = mmap(NULL, Capture->MapSize, PROT_READ, MAP_SHARED,
+                      Capture->Fd, 0);
+  if (Capture->Map == MAP_FAILED)
+  {
+    close(Capture->Fd);
+    Capture->Map = NULL;
+    return PCA9534_FAIL;
+  }
+
+  Header = (const PCA9534_CaptureHeader_t *)Capture->Map;
+  if (Header->Magic != PCA9534_CAPTURE_MAGIC ||
+      Header->Version != PCA9534_CAPTURE_VERSION ||
+      Header->DeviceCount > PCA9534_CAPTURE_DEVICES_MAX ||
+      Header->RecordSize != Capture_RecordSize(Header->DeviceCount) ||
+      !Header->Capacity ||
+      (Capture->MapSize - PCA9534_CAPTURE_HEADER_SIZE) / Header->RecordSize <
+      Header->Capacity)
+  {
+    munmap(Capture->Map, Capture->MapSize);
+    close(Capture->Fd);
+    Capture->Map = NULL;
+    return PCA9534_FAIL;
+  }
+
+  Capture->Header = (PCA9534_CaptureHeader_t *)Capture->Map;
+  posix_madvise(Capture->Map, Capture->MapSize, POSIX_MADV_SEQUENTIAL);
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Unmap and close the capture file
+ * @param  Capture: Pointer to capture session
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Close(PCA9534_Capture_t *Capture)
+{
+  if (!Capture || !Capture->Map)
+    return PCA9534_INVALID_PARAM;
+
+  if (Capture->Handlers)
+    msync(Capture->Map, Capture->MapSize, MS_SYNC);
+
+  munmap(Capture->Map, Capture->MapSize);
+  close(Capture->Fd);
+  Capture->Map = NULL;
+  Capture->Header = NULL;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Read the input port of all devices once and append a record
+ * @param  Capture: Pointer to capture session
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read at least one device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Sample(PCA9534_Capture_t *Capture)
+{
+  PCA9534_CaptureHeader_t *Header = NULL;
+  PCA9534_Result_t Result = PCA9534_OK;
+  uint64_t Time = 0;
+  uint8_t *Record = NULL;
+  uint16_t i = 0;
+
+  if (!Capture || !Capture->Header || !Capture->Handlers)
+    return PCA9534_INVALID_PARAM;
+
+  Header = Capture->Header;
+  Record = Capture_Record(Capture, Header->Written % Header->Capacity);
+
+  Time = Capture_Now(CLOCK_MONOTONIC);
+  for (i = 0; i < Header->DeviceCount; i++)
+  {
+    if (PCA9534_Read(Capture->Handlers[i], &Capture->Last[i]) != PCA9534_OK)
+    {
+      Header->Failures++;
+      Result = PCA9534_FAIL;
+    }
+  }
+
+  memcpy(Record, &Time, sizeof(Time));
+  memcpy(Record + sizeof(Time), Capture->Last, Header->DeviceCount);
+  Header->Written++;
+
+  if ((Header->Written % PCA9534_CAPTURE_RATE_PERIOD) == 0 &&
+      Time > Header->StartMonotonic)
+  {
+    Header->RateMilliHz =
+      (uint64_t)((double)Header->Written * 1e12 /
+                 (double)(Time - Header->StartMonotonic));
+  }
+
+  return Result;
+}
+
+
+/**
+ * @brief  Sample all devices back-to-back at the maximum bus rate
+ * @param  Capture: Pointer to capture session
+ * @param  Samples: Number of samples to take
+ * @param  Stop: Pointer to a flag that stops the capture when set (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Run(PCA9534_Capture_t *Capture, uint64_t Samples,
+                    volatile int *Stop)
+{
+  uint64_t i = 0;
+
+  if (!Capture || !Capture->Header || !Capture->Handlers)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < Samples; i++)
+  {
+    if (Stop && *Stop)
+      break;
+
+    // Failed reads are counted in the header and the capture goes on
+    PCA9534_Capture_Sample(Capture);
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Number of records available in the ring
+ * @param  Capture: Pointer to capture session
+ * @retval Number of records
+ */
+uint64_t
+PCA9534_Capture_Count(const PCA9534_Capture_t *Capture)
+{
+  if (!Capture || !Capture->Header)
+    return 0;
+
+  if (Capture->Header->Written < Capture->Header->Capacity)
+    return Capture->Header->Written;
+
+  return Capture->Header->Capacity;
+}
+
+
+/**
+ * @brief  Get one record of the ring
+ * @param  Capture: Pointer to capture session
+ * @param  Index: Index of record (0 is the oldest one)
+ * @param  Time: Pointer to monotonic time of record in ns (can be NULL)
+ * @retval Pointer to DeviceCount input bytes or NULL if Index is invalid
+ */
+const uint8_t *
+PCA9534_Capture_Get(const PCA9534_Capture_t *Capture, uint64_t Index,
+                    uint64_t *Time)
+{
+  const PCA9534_CaptureHeader_t *Header = NULL;
+  const uint8_t *Record = NULL;
+  uint64_t Count = PCA9534_Capture_Count(Capture);
+
+  if (Index >= Count)
+    return NULL;
+
+  Header = Capture->Header;
+  Record = Capture_Record(Capture, (Header->Written - Count + Index) %
+                                   Header->Capacity);
+  if (Time)
+    memcpy(Time, Record, sizeof(uint64_t));
+
+  return Record + sizeof(uint64_t);
+}
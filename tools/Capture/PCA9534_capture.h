@@ -0,0 +1,219 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_capture.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Continuous input capture into a memory-mapped ring file
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_CAPTURE_H_
+#define _PCA9534_CAPTURE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534.h"
+#include <stdint.h>
+#include <stddef.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Maximum number of devices of one capture
+ */
+#define PCA9534_CAPTURE_DEVICES_MAX   128
+
+
+
+/* Exported Constants -----------------------------------------------------------*/
+#define PCA9534_CAPTURE_MAGIC         0x52433950  // "P9CR"
+#define PCA9534_CAPTURE_VERSION       1
+#define PCA9534_CAPTURE_HEADER_SIZE   256
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Capture file header (first PCA9534_CAPTURE_HEADER_SIZE bytes)
+ * @note   The header is followed by Capacity fixed-size records. Each record
+ *         is a uint64_t monotonic time in ns followed by one input byte per
+ *         device, padded to a multiple of 8 bytes. The ring is full when
+ *         Written >= Capacity; record (Written % Capacity) is the next one to
+ *         be overwritten.
+ */
+typedef struct PCA9534_CaptureHeader_s
+{
+  uint32_t Magic;
+  uint16_t Version;
+  // Size of one record in Bytes
+  uint16_t RecordSize;
+  // Number of records of the ring
+  uint64_t Capacity;
+  // Number of records written since the capture was created
+  uint64_t Written;
+  // CLOCK_REALTIME and CLOCK_MONOTONIC at the start of capture (ns)
+  uint64_t StartRealtime;
+  uint64_t StartMonotonic;
+  // Measured sample rate in mHz (updated while capturing)
+  uint64_t RateMilliHz;
+  // Number of failed device reads (the previous value is recorded)
+  uint32_t Failures;
+  // Number of devices
+  uint16_t DeviceCount;
+  uint16_t Reserved;
+  // I2C address of each device
+  uint8_t Devices[PCA9534_CAPTURE_DEVICES_MAX];
+} PCA9534_CaptureHeader_t;
+
+/**
+ * @brief  Capture session data type
+ */
+typedef struct PCA9534_Capture_s
+{
+  // Mapped file
+  uint8_t *Map;
+  size_t MapSize;
+  int Fd;
+
+  // Header inside the mapped file
+  PCA9534_CaptureHeader_t *Header;
+
+  // Devices to sample (NULL for read-only sessions)
+  PCA9534_Handler_t **Handlers;
+
+  // Last value of each device
+  uint8_t Last[PCA9534_CAPTURE_DEVICES_MAX];
+} PCA9534_Capture_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Create a capture file and map it
+ * @note   The whole file is allocated here, so sampling does not allocate or
+ *         call the kernel (timestamps come from the vDSO clock).
+ * @param  Capture: Pointer to capture session
+ * @param  Path: Path of capture file
+ * @param  Handlers: Array of pointers to initialized handlers
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @param  Capacity: Number of records of the ring
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to create or map the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Create(PCA9534_Capture_t *Capture, const char *Path,
+                       PCA9534_Handler_t **Handlers, uint16_t DeviceCount,
+                       uint64_t Capacity);
+
+
+/**
+ * @brief  Map an existing capture file read-only
+ * @param  Capture: Pointer to capture session
+ * @param  Path: Path of capture file
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to open the file or the file is invalid.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Open(PCA9534_Capture_t *Capture, const char *Path);
+
+
+/**
+ * @brief  Unmap and close the capture file
+ * @param  Capture: Pointer to capture session
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Close(PCA9534_Capture_t *Capture);
+
+
+/**
+ * @brief  Read the input port of all devices once and append a record
+ * @param  Capture: Pointer to capture session
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read at least one device.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Sample(PCA9534_Capture_t *Capture);
+
+
+/**
+ * @brief  Sample all devices back-to-back at the maximum bus rate
+ * @param  Capture: Pointer to capture session
+ * @param  Samples: Number of samples to take
+ * @param  Stop: Pointer to a flag that stops the capture when set (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Capture_Run(PCA9534_Capture_t *Capture, uint64_t Samples,
+                    volatile int *Stop);
+
+
+/**
+ * @brief  Number of records available in the ring
+ * @param  Capture: Pointer to capture session
+ * @retval Number of records
+ */
+uint64_t
+PCA9534_Capture_Count(const PCA9534_Capture_t *Capture);
+
+
+/**
+ * @brief  Get one record of the ring
+ * @param  Capture: Pointer to capture session
+ * @param  Index: Index of record (0 is the oldest one)
+ * @param  Time: Pointer to monotonic time of record in ns (can be NULL)
+ * @retval Pointer to DeviceCount input bytes or NULL if Index is invalid
+ */
+const uint8_t *
+PCA9534_Capture_Get(const PCA9534_Capture_t *Capture, uint64_t Index,
+                    uint64_t *Time);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_CAPTURE_H_
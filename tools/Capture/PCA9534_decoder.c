@@ -0,0 +1,428 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_decoder.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Parallel multi-core decoder for capture files
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_decoder.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Records gathered per device before running the edge kernel
+#define PCA9534_DECODER_BLOCK   1024
+
+
+
+/* Private Data Types -----------------------------------------------------------*/
+/**
+ * @brief  Result of one device in one chunk
+ */
+typedef struct Decoder_Slot_s
+{
+  PCA9534_Edges_t Edges;
+
+  // First sample of the chunk
+  uint64_t ChunkStart;
+
+  // (Filtered) value before the chunk
+  uint8_t StartValue;
+
+  // Length of the first run of each pin, cut by the chunk start
+  uint64_t Head[8];
+  uint8_t HeadSeen;
+
+  // Debounce filter state at the start and at the end of the chunk
+  PCA9534_Filter_t FilterStart;
+  PCA9534_Filter_t FilterEnd;
+} Decoder_Slot_t;
+
+/**
+ * @brief  Decoder session
+ */
+typedef struct Decoder_s
+{
+  const PCA9534_Capture_t *Capture;
+  const PCA9534_Filter_t *Filter;
+  uint16_t Devices;
+  uint64_t Count;
+  uint32_t Chunks;
+  uint64_t ChunkSize;
+
+  // Slots[Chunk * Devices + Device]
+  Decoder_Slot_t *Slots;
+
+  // Next chunk to be taken by a worker
+  pthread_mutex_t Lock;
+  uint32_t Next;
+} Decoder_t;
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint8_t
+Decoder_Bucket(uint64_t Length)
+{
+  uint8_t n = 0;
+
+  while (Length >>= 1)
+    n++;
+
+  return (n < PCA9534_EDGES_BUCKETS) ? n : (PCA9534_EDGES_BUCKETS - 1);
+}
+
+
+static uint8_t
+Decoder_Sample(const Decoder_t *Decoder, uint64_t Index, uint16_t Device)
+{
+  return PCA9534_Capture_Get(Decoder->Capture, Index, NULL)[Device];
+}
+
+
+static void
+Decoder_FilterReset(PCA9534_Filter_t *Filter, const PCA9534_Filter_t *Template,
+                    uint8_t State)
+{
+  *Filter = *Template;
+  Filter->State = State;
+  Filter->History[0] = State;
+  Filter->History[1] = State;
+  memset(Filter->Count, 0, sizeof(Filter->Count));
+}
+
+
+static void
+Decoder_Head(void *Context, uint8_t Pin, uint8_t Level, uint64_t Start,
+             uint64_t Length)
+{
+  Decoder_Slot_t *Slot = (Decoder_Slot_t *)Context;
+  (void)Level;
+
+  if (Start == Slot->ChunkStart && !(Slot->HeadSeen & (1 << Pin)))
+  {
+    Slot->HeadSeen |= (1 << Pin);
+    Slot->Head[Pin] = Length;
+  }
+}
+
+
+/**
+ * @brief  Decode devices [First, Last) of one chunk
+ * @note   If Rebuild is 0, the filter start state is rebuilt from the samples
+ *         before the chunk. Otherwise FilterStart of the slot is used as is.
+ */
+static void
+Decoder_Chunk(Decoder_t *Decoder, uint32_t Chunk, uint16_t First,
+              uint16_t Last, uint8_t Rebuild, uint8_t *Buffer)
+{
+  const PCA9534_Filter_t *Filter = Decoder->Filter;
+  Decoder_Slot_t *Slots = &Decoder->Slots[Chunk * Decoder->Devices];
+  Decoder_Slot_t *Slot = NULL;
+  uint64_t Start = Chunk * Decoder->ChunkSize;
+  uint64_t End = Start + Decoder->ChunkSize;
+  uint64_t Warmup = 0;
+  uint64_t Index = 0;
+  uint64_t Len = 0;
+  uint64_t i = 0;
+  const uint8_t *Record = NULL;
+  uint16_t d = 0;
+  uint8_t Pin = 0;
+
+  if (End > Decoder->Count)
+    End = Decoder->Count;
+
+  for (d = First; d < Last; d++)
+  {
+    Slot = &Slots[d];
+
+    if (Filter && !Rebuild)
+    {
+      Warmup = (Start > PCA9534_DECODER_WARMUP) ?
+               (Start - PCA9534_DECODER_WARMUP) : 0;
+      Decoder_FilterReset(&Slot->FilterStart, Filter,
+                          Decoder_Sample(Decoder, Warmup, d));
+      for (Index = Warmup; Index < Start; Index++)
+        PCA9534_Filter_Update(&Slot->FilterStart,
+                              Decoder_Sample(Decoder, Index, d));
+    }
+
+    if (Filter)
+      Slot->StartValue = Slot->FilterStart.State;
+    else
+      Slot->StartValue = Decoder_Sample(Decoder, Start ? (Start - 1) : 0, d);
+
+    Slot->FilterEnd = Slot->FilterStart;
+    Slot->ChunkStart = Start;
+    Slot->HeadSeen = 0;
+    PCA9534_Edges_Init(&Slot->Edges, Decoder_Head, Slot);
+    Slot->Edges.Started = 1;
+    Slot->Edges.Last = Slot->StartValue;
+    Slot->Edges.Position = Start;
+    for (Pin = 0; Pin < 8; Pin++)
+      Slot->Edges.Since[Pin] = Start;
+  }
+
+  for (Index = Start; Index < End; Index += Len)
+  {
+    Len = End - Index;
+    if (Len > PCA9534_DECODER_BLOCK)
+      Len = PCA9534_DECODER_BLOCK;
+
+    for (i = 0; i < Len; i++)
+    {
+      Record = PCA9534_Capture_Get(Decoder->Capture, Index + i, NULL);
+      for (d = First; d < Last; d++)
+      {
+        if (Filter)
+        {
+          PCA9534_Filter_Update(&Slots[d].FilterEnd, Record[d]);
+          Buffer[(d - First) * PCA9534_DECODER_BLOCK + i] =
+            Slots[d].FilterEnd.State;
+        }
+        else
+          Buffer[(d - First) * PCA9534_DECODER_BLOCK + i] = Record[d];
+      }
+    }
+
+    for (d = First; d < Last; d++)
+      PCA9534_Edges_Process(&Slots[d].Edges,
+                            &Buffer[(d - First) * PCA9534_DECODER_BLOCK], Len);
+  }
+}
+
+
+static void *
+Decoder_Worker(void *Argument)
+{
+  Decoder_t *Decoder = (Decoder_t *)Argument;
+  uint8_t *Buffer = NULL;
+  uint32_t Chunk = 0;
+
+  // Chunks left by a worker that can not start are taken by the others
+  Buffer = malloc((size_t)Decoder->Devices * PCA9534_DECODER_BLOCK);
+  if (!Buffer)
+    return NULL;
+
+  for (;;)
+  {
+    pthread_mutex_lock(&Decoder->Lock);
+    Chunk = Decoder->Next++;
+    pthread_mutex_unlock(&Decoder->Lock);
+
+    if (Chunk >= Decoder->Chunks)
+      break;
+
+    Decoder_Chunk(Decoder, Chunk, 0, Decoder->Devices, 0, Buffer);
+  }
+
+  free(Buffer);
+  return NULL;
+}
+
+
+/**
+ * @brief  Merge the chunks of one device in order and join the runs cut by
+ *         chunk boundaries
+ */
+static void
+Decoder_Merge(Decoder_t *Decoder, uint16_t Device, uint8_t *Buffer,
+              PCA9534_Edges_t *Result)
+{
+  Decoder_Slot_t *Slot = NULL;
+  const PCA9534_Edges_t *Edges = NULL;
+  uint64_t Carry[8] = {0};
+  uint64_t ChunkLen = 0;
+  uint32_t Chunk = 0;
+  uint8_t Level = 0;
+  uint8_t Pin = 0;
+  uint8_t b = 0;
+
+  for (Chunk = 0; Chunk < Decoder->Chunks; Chunk++)
+  {
+    Slot = &Decoder->Slots[Chunk * Decoder->Devices + Device];
+
+    // The rebuilt filter state was wrong: decode the chunk again
+    if (Decoder->Filter && Chunk &&
+        memcmp(&Slot->FilterStart, &(Slot - Decoder->Devices)->FilterEnd,
+               sizeof(PCA9534_Filter_t)) != 0)
+    {
+      Slot->FilterStart = (Slot - Decoder->Devices)->FilterEnd;
+      Decoder_Chunk(Decoder, Chunk, Device, Device + 1, 1, Buffer);
+    }
+
+    Edges = &Slot->Edges;
+    ChunkLen = Edges->Position - Slot->ChunkStart;
+
+    for (Pin = 0; Pin < 8; Pin++)
+    {
+      Result->Rising[Pin] += Edges->Rising[Pin];
+      Result->Falling[Pin] += Edges->Falling[Pin];
+      Result->High[Pin] += Edges->High[Pin];
+      Result->Completed[Pin] += Edges->Completed[Pin];
+      for (Level = 0; Level < 2; Level++)
+      {
+        for (b = 0; b < PCA9534_EDGES_BUCKETS; b++)
+          Result->Width[Pin][Level][b] += Edges->Width[Pin][Level][b];
+      }
+
+      if (!(Slot->HeadSeen & (1 << Pin)))
+      {
+        Carry[Pin] += ChunkLen;
+        continue;
+      }
+
+      // Join the cut head run with the open run of the previous chunks
+      Level = (Slot->StartValue >> Pin) & 0x01;
+      Result->Width[Pin][Level][Decoder_Bucket(Slot->Head[Pin])]--;
+      Result->Width[Pin][Level][Decoder_Bucket(Slot->Head[Pin] +
+                                               Carry[Pin])]++;
+      Result->Completed[Pin] += Carry[Pin];
+      if (Level)
+        Result->High[Pin] += Carry[Pin];
+
+      Carry[Pin] = Edges->Position - Edges->Since[Pin];
+    }
+
+    Result->Last = Edges->Last;
+  }
+
+  Result->Started = 1;
+  Result->Position = Decoder->Count;
+  for (Pin = 0; Pin < 8; Pin++)
+    Result->Since[Pin] = Decoder->Count - Carry[Pin];
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Decode a whole capture with a pool of worker threads
+ * @note   The capture is split into chunks that are taken by idle workers.
+ *         Runs that cross chunk boundaries are joined while merging, so the
+ *         results are the same as a single-threaded pass. The open run of
+ *         every pin is left open; call PCA9534_Edges_Finish to close them.
+ * @param  Capture: Pointer to capture session
+ * @param  Filter: Debounce filter applied to every device before edge
+ *                 detection (can be NULL)
+ * @param  Threads: Number of worker threads (1 <= Threads)
+ * @param  Results: Array of DeviceCount analyzers, initialized here (Run
+ *                  callbacks are not called)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to allocate memory or start threads.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Decoder_Run(const PCA9534_Capture_t *Capture,
+                    const PCA9534_Filter_t *Filter, uint32_t Threads,
+                    PCA9534_Edges_t *Results)
+{
+  PCA9534_Result_t Result = PCA9534_OK;
+  Decoder_t Decoder;
+  pthread_t *Workers = NULL;
+  uint8_t *Buffer = NULL;
+  uint32_t Started = 0;
+  uint32_t i = 0;
+  uint16_t d = 0;
+
+  if (!Capture || !Capture->Header || !Results || !Threads)
+    return PCA9534_INVALID_PARAM;
+
+  memset(&Decoder, 0, sizeof(Decoder));
+  Decoder.Capture = Capture;
+  Decoder.Filter = Filter;
+  Decoder.Devices = Capture->Header->DeviceCount;
+  Decoder.Count = PCA9534_Capture_Count(Capture);
+
+  for (d = 0; d < Decoder.Devices; d++)
+    PCA9534_Edges_Init(&Results[d], NULL, NULL);
+
+  if (!Decoder.Count)
+    return PCA9534_OK;
+
+  Decoder.Chunks = Threads * PCA9534_DECODER_CHUNKS_PER_THREAD;
+  if (Decoder.Chunks > Decoder.Count)
+    Decoder.Chunks = (uint32_t)Decoder.Count;
+  Decoder.ChunkSize = (Decoder.Count + Decoder.Chunks - 1) / Decoder.Chunks;
+  Decoder.Chunks = (uint32_t)((Decoder.Count + Decoder.ChunkSize - 1) /
+                              Decoder.ChunkSize);
+
+  Decoder.Slots = calloc((size_t)Decoder.Chunks * Decoder.Devices,
+                         sizeof(Decoder_Slot_t));
+  Workers = calloc(Threads, sizeof(pthread_t));
+  Buffer = malloc(PCA9534_DECODER_BLOCK);
+  if (!Decoder.Slots || !Workers || !Buffer ||
+      pthread_mutex_init(&Decoder.Lock, NULL) != 0)
+  {
+    free(Decoder.Slots);
+    free(Workers);
+    free(Buffer);
+    return PCA9534_FAIL;
+  }
+
+  for (Started = 0; Started < Threads; Started++)
+  {
+    if (pthread_create(&Workers[Started], NULL, Decoder_Worker, &Decoder) != 0)
+      break;
+  }
+
+  // With no worker there is nobody to decode the chunks
+  if (!Started)
+    Decoder_Worker(&Decoder);
+
+  for (i = 0; i < Started; i++)
+    pthread_join(Workers[i], NULL);
+
+  if (Decoder.Next < Decoder.Chunks)
+    Result = PCA9534_FAIL;
+
+  if (Result == PCA9534_OK)
+  {
+    for (d = 0; d < Decoder.Devices; d++)
+      Decoder_Merge(&Decoder, d, Buffer, &Results[d]);
+  }
+
+  pthread_mutex_destroy(&Decoder.Lock);
+  free(Decoder.Slots);
+  free(Workers);
+  free(Buffer);
+
+  return Result;
+}
@@ -0,0 +1,96 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_decoder.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Parallel multi-core decoder for capture files
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_DECODER_H_
+#define _PCA9534_DECODER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_capture.h"
+#include "PCA9534_edges.h"
+#include "PCA9534_Filter.h"
+#include <stdint.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Chunks per worker thread (more chunks give better load balance)
+ */
+#define PCA9534_DECODER_CHUNKS_PER_THREAD   4
+
+/**
+ * @brief  Samples fed to the debounce filter before a chunk to rebuild its
+ *         state. If the rebuilt state is wrong, the chunk is decoded again
+ *         while merging.
+ */
+#define PCA9534_DECODER_WARMUP              64
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Decode a whole capture with a pool of worker threads
+ * @note   The capture is split into chunks that are taken by idle workers.
+ *         Runs that cross chunk boundaries are joined while merging, so the
+ *         results are the same as a single-threaded pass. The open run of
+ *         every pin is left open; call PCA9534_Edges_Finish to close them.
+ * @param  Capture: Pointer to capture session
+ * @param  Filter: Debounce filter applied to every device before edge
+ *                 detection (can be NULL)
+ * @param  Threads: Number of worker threads (1 <= Threads)
+ * @param  Results: Array of DeviceCount analyzers, initialized here (Run
+ *                  callbacks are not called)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to allocate memory or start threads.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Decoder_Run(const PCA9534_Capture_t *Capture,
+                    const PCA9534_Filter_t *Filter, uint32_t Threads,
+                    PCA9534_Edges_t *Results);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_DECODER_H_
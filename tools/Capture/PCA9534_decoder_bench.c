@@ -0,0 +1,259 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_decoder_bench.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Multi-threaded capture decoder scaling benchmark
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/**
+ * Usage: PCA9534_decoder_bench [max-threads [capture-file]]
+ *
+ * Decodes a capture with 1 to max-threads worker threads (default: number of
+ * online cores), checks that every result is the same as the 1-thread result
+ * and prints the time and the speedup of each thread count. Without a
+ * capture file, a synthetic capture of PCA9534_BENCH_DEVICES devices and
+ * PCA9534_BENCH_SAMPLES samples is taken from a simulated bus.
+ *
+ * Build:
+ *   cc -O2 -march=native -pthread -Isrc/include -Itools/Capture \
+ *      tools/Capture/PCA9534_decoder_bench.c tools/Capture/PCA9534_decoder.c \
+ *      tools/Capture/PCA9534_edges.c tools/Capture/PCA9534_capture.c \
+ *      src/PCA9534_Filter.c src/PCA9534.c
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include "PCA9534_decoder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Devices and samples of the synthetic capture
+#define PCA9534_BENCH_DEVICES   16
+#define PCA9534_BENCH_SAMPLES   (1u << 21)
+
+// Debounce samples of the filter
+#define PCA9534_BENCH_DEBOUNCE  3
+
+// Path of the synthetic capture
+#define PCA9534_BENCH_PATH      "/tmp/PCA9534_decoder_bench.cap"
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+// Simulated input port of each I2C address and PRNG state
+static uint8_t Bench_Input[128];
+static uint32_t Bench_Seed = 1;
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint64_t
+Bench_Now(void)
+{
+  struct timespec Ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &Ts);
+  return (uint64_t)Ts.tv_sec * 1000000000ull + (uint64_t)Ts.tv_nsec;
+}
+
+
+static int8_t
+Bench_Send(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  (void)Address;
+  (void)Data;
+  (void)DataLen;
+  return 0;
+}
+
+
+// Input port with a pin toggling in about one of 8 reads (bounces included)
+static int8_t
+Bench_Receive(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  uint8_t i = 0;
+
+  Address &= 0x7F;
+  Bench_Seed = Bench_Seed * 1103515245u + 12345u;
+  if (((Bench_Seed >> 16) & 0x07) == 0)
+    Bench_Input[Address] ^= (uint8_t)(1u << ((Bench_Seed >> 20) & 0x07));
+
+  for (i = 0; i < DataLen; i++)
+    Data[i] = Bench_Input[Address];
+
+  return 0;
+}
+
+
+static int
+Bench_Synthesize(PCA9534_Capture_t *Capture)
+{
+  static PCA9534_Handler_t Handler[PCA9534_BENCH_DEVICES];
+  static PCA9534_Handler_t *Handlers[PCA9534_BENCH_DEVICES];
+  uint16_t i = 0;
+
+  for (i = 0; i < PCA9534_BENCH_DEVICES; i++)
+  {
+    PCA9534_PLATFORM_LINK_SEND(&Handler[i], Bench_Send);
+    PCA9534_PLATFORM_LINK_RECEIVE(&Handler[i], Bench_Receive);
+    if (PCA9534_Init(&Handler[i], (i < 8) ? PCA9534_DEVICE_PCA9534 :
+                     PCA9534_DEVICE_PCA9534A, i % 8) != PCA9534_OK)
+      return -1;
+    Handlers[i] = &Handler[i];
+  }
+
+  if (PCA9534_Capture_Create(Capture, PCA9534_BENCH_PATH, Handlers,
+                             PCA9534_BENCH_DEVICES,
+                             PCA9534_BENCH_SAMPLES) != PCA9534_OK)
+    return -1;
+
+  if (PCA9534_Capture_Run(Capture, PCA9534_BENCH_SAMPLES, NULL) != PCA9534_OK)
+    return -1;
+
+  return 0;
+}
+
+
+static int
+Bench_Same(const PCA9534_Edges_t *A, const PCA9534_Edges_t *B)
+{
+  return A->Last == B->Last && A->Started == B->Started &&
+         A->Position == B->Position &&
+         memcmp(A->Since, B->Since, sizeof(A->Since)) == 0 &&
+         memcmp(A->Rising, B->Rising, sizeof(A->Rising)) == 0 &&
+         memcmp(A->Falling, B->Falling, sizeof(A->Falling)) == 0 &&
+         memcmp(A->High, B->High, sizeof(A->High)) == 0 &&
+         memcmp(A->Completed, B->Completed, sizeof(A->Completed)) == 0 &&
+         memcmp(A->Width, B->Width, sizeof(A->Width)) == 0;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+int
+main(int argc, char **argv)
+{
+  PCA9534_Capture_t Capture;
+  PCA9534_Filter_t Filter;
+  PCA9534_Edges_t *Reference = NULL;
+  PCA9534_Edges_t *Results = NULL;
+  uint64_t Time = 0;
+  uint64_t TimeOne = 0;
+  uint32_t MaxThreads = 0;
+  uint32_t Threads = 0;
+  uint16_t DeviceCount = 0;
+  uint16_t i = 0;
+  int Failed = 0;
+  int Same = 0;
+
+  MaxThreads = (argc > 1) ? (uint32_t)atoi(argv[1]) :
+                            (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+  if (!MaxThreads)
+    MaxThreads = 1;
+
+  if (argc > 2)
+  {
+    if (PCA9534_Capture_Open(&Capture, argv[2]) != PCA9534_OK)
+    {
+      fprintf(stderr, "Can not open capture %s\n", argv[2]);
+      return 1;
+    }
+  }
+  else if (Bench_Synthesize(&Capture) != 0)
+  {
+    fprintf(stderr, "Can not create synthetic capture\n");
+    return 1;
+  }
+
+  DeviceCount = Capture.Header->DeviceCount;
+  Reference = calloc(DeviceCount, sizeof(PCA9534_Edges_t));
+  Results = calloc(DeviceCount, sizeof(PCA9534_Edges_t));
+  if (!Reference || !Results)
+  {
+    fprintf(stderr, "Out of memory\n");
+    return 1;
+  }
+
+  PCA9534_Filter_Init(&Filter, 0x00);
+  PCA9534_Filter_SetSamples(&Filter, 0xFF, PCA9534_BENCH_DEBOUNCE);
+
+  printf("devices: %u, samples: %llu\n", DeviceCount,
+         (unsigned long long)PCA9534_Capture_Count(&Capture));
+  printf("threads     time(ms)  Msamples/s  speedup  result\n");
+
+  for (Threads = 1; Threads <= MaxThreads; Threads++)
+  {
+    Time = Bench_Now();
+    if (PCA9534_Decoder_Run(&Capture, &Filter, Threads,
+                            (Threads == 1) ? Reference : Results) != PCA9534_OK)
+    {
+      fprintf(stderr, "Decoder failed with %u threads\n", Threads);
+      return 1;
+    }
+    Time = Bench_Now() - Time;
+    if (!Time)
+      Time = 1;
+
+    Same = 1;
+    if (Threads == 1)
+    {
+      TimeOne = Time;
+    }
+    else
+    {
+      for (i = 0; i < DeviceCount; i++)
+        Same &= Bench_Same(&Reference[i], &Results[i]);
+    }
+    Failed |= !Same;
+
+    printf("%7u  %11.2f  %10.1f  %7.2f  %s\n", Threads, Time / 1e6,
+           PCA9534_Capture_Count(&Capture) * DeviceCount * 1e3 / Time,
+           (double)TimeOne / Time, Same ? "same" : "DIFFERENT");
+  }
+
+  free(Reference);
+  free(Results);
+  PCA9534_Capture_Close(&Capture);
+  if (argc <= 2)
+    remove(PCA9534_BENCH_PATH);
+
+  return Failed ? 2 : 0;
+}
@@ -0,0 +1,318 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_edges.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Edge detection, run-length encoding and pulse statistics of captures
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_edges.h"
+#include <string.h>
+#if PCA9534_EDGES_SIMD && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Samples scanned per call of the change kernel
+#define PCA9534_EDGES_BLOCK   4096
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint8_t
+Edges_Ctz(uint32_t x)
+{
+#if defined(__GNUC__)
+  return (uint8_t)__builtin_ctz(x);
+#else
+  uint8_t n = 0;
+  while (!(x & 0x01))
+  {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+
+static uint8_t
+Edges_Log2(uint64_t x)
+{
+#if defined(__GNUC__)
+  return (uint8_t)(63 - __builtin_clzll(x));
+#else
+  uint8_t n = 0;
+  while (x >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+
+static uint64_t
+Edges_Load64(const uint8_t *Data)
+{
+  uint64_t x = 0;
+  memcpy(&x, Data, sizeof(x));
+  return x;
+}
+
+
+static void
+Edges_EndRun(PCA9534_Edges_t *Edges, uint8_t Pin, uint8_t Level,
+             uint64_t Length)
+{
+  uint8_t Bucket = Length ? Edges_Log2(Length) : 0;
+
+  if (Bucket >= PCA9534_EDGES_BUCKETS)
+    Bucket = PCA9534_EDGES_BUCKETS - 1;
+
+  Edges->Width[Pin][Level][Bucket]++;
+  Edges->Completed[Pin] += Length;
+  if (Level)
+    Edges->High[Pin] += Length;
+
+  if (Edges->Run)
+    Edges->Run(Edges->Context, Pin, Level, Edges->Since[Pin], Length);
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Find the positions where a sample differs from the previous one
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @param  Prev: Sample before Samples[0]
+ * @param  Positions: Pointer to output (at least Count entries)
+ * @retval Number of positions found
+ */
+uint32_t
+PCA9534_Edges_Find(const uint8_t *Samples, uint32_t Count, uint8_t Prev,
+                   uint32_t *Positions)
+{
+  uint32_t Found = 0;
+  uint32_t i = 1;
+  uint32_t j = 0;
+  uint64_t Diff = 0;
+
+  if (!Count)
+    return 0;
+
+  if (Samples[0] != Prev)
+    Positions[Found++] = 0;
+
+  // Compare every sample with the previous one: XOR (or compare) with the
+  // stream shifted by one, movemask, then walk the set bits with ctz
+#if PCA9534_EDGES_SIMD && defined(__AVX2__)
+  for (; i + 32 <= Count; i += 32)
+  {
+    __m256i Cur = _mm256_loadu_si256((const __m256i *)&Samples[i]);
+    __m256i Old = _mm256_loadu_si256((const __m256i *)&Samples[i - 1]);
+    uint32_t Mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(Cur, Old));
+    while (Mask)
+    {
+      Positions[Found++] = i + Edges_Ctz(Mask);
+      Mask &= Mask - 1;
+    }
+  }
+#elif PCA9534_EDGES_SIMD && defined(__SSE2__)
+  for (; i + 16 <= Count; i += 16)
+  {
+    __m128i Cur = _mm_loadu_si128((const __m128i *)&Samples[i]);
+    __m128i Old = _mm_loadu_si128((const __m128i *)&Samples[i - 1]);
+    uint32_t Mask = (~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(Cur, Old))) & 0xFFFF;
+    while (Mask)
+    {
+      Positions[Found++] = i + Edges_Ctz(Mask);
+      Mask &= Mask - 1;
+    }
+  }
+#endif
+
+  // Portable path: 8 samples per step, skip words without changes
+  for (; i + 8 <= Count; i += 8)
+  {
+    Diff = Edges_Load64(&Samples[i]) ^ Edges_Load64(&Samples[i - 1]);
+    if (!Diff)
+      continue;
+
+    for (j = 0; j < 8; j++)
+    {
+      if (Samples[i + j] != Samples[i + j - 1])
+        Positions[Found++] = i + j;
+    }
+  }
+
+  for (; i < Count; i++)
+  {
+    if (Samples[i] != Samples[i - 1])
+      Positions[Found++] = i;
+  }
+
+  return Found;
+}
+
+
+/**
+ * @brief  Initialize the analyzer
+ * @param  Edges: Pointer to analyzer
+ * @param  Run: Run callback for run-length encoding (can be NULL)
+ * @param  Context: User pointer passed to Run
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Edges_Init(PCA9534_Edges_t *Edges, PCA9534_Edges_Run_t Run,
+                   void *Context)
+{
+  if (!Edges)
+    return PCA9534_INVALID_PARAM;
+
+  memset(Edges, 0, sizeof(PCA9534_Edges_t));
+  Edges->Run = Run;
+  Edges->Context = Context;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Process the next block of samples of one device
+ * @note   Work is proportional to the number of changes: unchanged samples
+ *         are skipped by the vector kernel and only changed pins are visited.
+ * @param  Edges: Pointer to analyzer
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Edges_Process(PCA9534_Edges_t *Edges, const uint8_t *Samples,
+                      uint64_t Count)
+{
+  uint32_t Positions[PCA9534_EDGES_BLOCK];
+  uint32_t Found = 0;
+  uint32_t Len = 0;
+  uint32_t i = 0;
+  uint64_t Index = 0;
+  uint8_t Changed = 0;
+  uint8_t Pin = 0;
+
+  if (!Edges || (!Samples && Count))
+    return PCA9534_INVALID_PARAM;
+
+  if (!Count)
+    return PCA9534_OK;
+
+  if (!Edges->Started)
+  {
+    Edges->Started = 1;
+    Edges->Last = Samples[0];
+    for (Pin = 0; Pin < 8; Pin++)
+      Edges->Since[Pin] = Edges->Position;
+  }
+
+  while (Count)
+  {
+    Len = (Count > PCA9534_EDGES_BLOCK) ?
+          PCA9534_EDGES_BLOCK : (uint32_t)Count;
+    Found = PCA9534_Edges_Find(Samples, Len, Edges->Last, Positions);
+
+    for (i = 0; i < Found; i++)
+    {
+      Index = Edges->Position + Positions[i];
+      Changed = Samples[Positions[i]] ^ Edges->Last;
+
+      while (Changed)
+      {
+        Pin = Edges_Ctz(Changed);
+        Changed &= Changed - 1;
+
+        if ((Edges->Last >> Pin) & 0x01)
+        {
+          Edges_EndRun(Edges, Pin, 1, Index - Edges->Since[Pin]);
+          Edges->Falling[Pin]++;
+        }
+        else
+        {
+          Edges_EndRun(Edges, Pin, 0, Index - Edges->Since[Pin]);
+          Edges->Rising[Pin]++;
+        }
+        Edges->Since[Pin] = Index;
+      }
+
+      Edges->Last = Samples[Positions[i]];
+    }
+
+    Edges->Position += Len;
+    Samples += Len;
+    Count -= Len;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Close the open run of every pin (end of stream)
+ * @param  Edges: Pointer to analyzer
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Edges_Finish(PCA9534_Edges_t *Edges)
+{
+  uint8_t Pin = 0;
+
+  if (!Edges)
+    return PCA9534_INVALID_PARAM;
+
+  for (Pin = 0; Pin < 8; Pin++)
+  {
+    if (Edges->Position > Edges->Since[Pin])
+      Edges_EndRun(Edges, Pin, (Edges->Last >> Pin) & 0x01,
+                   Edges->Position - Edges->Since[Pin]);
+    Edges->Since[Pin] = Edges->Position;
+  }
+
+  return PCA9534_OK;
+}
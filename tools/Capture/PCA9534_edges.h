@@ -0,0 +1,175 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_edges.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Edge detection, run-length encoding and pulse statistics of captures
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_EDGES_H_
+#define _PCA9534_EDGES_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534.h"
+#include <stdint.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Use SSE2/AVX2 kernels when the compiler targets them
+ * @note   Set it to 0 to force the portable kernel.
+ */
+#ifndef PCA9534_EDGES_SIMD
+#define PCA9534_EDGES_SIMD      1
+#endif
+
+/**
+ * @brief  Number of log2 buckets of pulse-width histograms
+ */
+#define PCA9534_EDGES_BUCKETS   32
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Function type for receiving per-pin runs (run-length encoding)
+ * @param  Context: User pointer given to PCA9534_Edges_Init
+ * @param  Pin: Pin number (0 <= Pin <= 7)
+ * @param  Level: Level of pin during the run
+ * @param  Start: Index of first sample of the run
+ * @param  Length: Number of samples of the run
+ */
+typedef void (*PCA9534_Edges_Run_t)(void *Context, uint8_t Pin, uint8_t Level,
+                                    uint64_t Start, uint64_t Length);
+
+/**
+ * @brief  Edge analyzer data type
+ * @note   Positions and widths are in samples. Bucket 0 of the histograms
+ *         counts pulses of 1 sample and bucket i counts widths in
+ *         [2^i, 2^(i+1)).
+ */
+typedef struct PCA9534_Edges_s
+{
+  // Value of the last sample
+  uint8_t Last;
+  // 0 until the first sample is processed
+  uint8_t Started;
+
+  // Index of the next sample
+  uint64_t Position;
+
+  // Index where the current run of each pin started
+  uint64_t Since[8];
+
+  // Edge counts of each pin
+  uint64_t Rising[8];
+  uint64_t Falling[8];
+
+  // Samples of completed runs at high level (duty = High / completed samples)
+  uint64_t High[8];
+  uint64_t Completed[8];
+
+  // Pulse-width histograms of each pin: [Pin][Level][Bucket]
+  uint64_t Width[8][2][PCA9534_EDGES_BUCKETS];
+
+  // Run callback (can be NULL)
+  PCA9534_Edges_Run_t Run;
+  void *Context;
+} PCA9534_Edges_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Find the positions where a sample differs from the previous one
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @param  Prev: Sample before Samples[0]
+ * @param  Positions: Pointer to output (at least Count entries)
+ * @retval Number of positions found
+ */
+uint32_t
+PCA9534_Edges_Find(const uint8_t *Samples, uint32_t Count, uint8_t Prev,
+                   uint32_t *Positions);
+
+
+/**
+ * @brief  Initialize the analyzer
+ * @param  Edges: Pointer to analyzer
+ * @param  Run: Run callback for run-length encoding (can be NULL)
+ * @param  Context: User pointer passed to Run
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Edges_Init(PCA9534_Edges_t *Edges, PCA9534_Edges_Run_t Run,
+                   void *Context);
+
+
+/**
+ * @brief  Process the next block of samples of one device
+ * @note   Work is proportional to the number of changes: unchanged samples
+ *         are skipped by the vector kernel and only changed pins are visited.
+ * @param  Edges: Pointer to analyzer
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Edges_Process(PCA9534_Edges_t *Edges, const uint8_t *Samples,
+                      uint64_t Count);
+
+
+/**
+ * @brief  Close the open run of every pin (end of stream)
+ * @param  Edges: Pointer to analyzer
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Edges_Finish(PCA9534_Edges_t *Edges);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_EDGES_H_
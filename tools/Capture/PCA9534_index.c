@@ -0,0 +1,482 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_index.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Time-indexed capture container with keyframes and random seek
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include "PCA9534_index.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint32_t
+Index_KeyframeSize(uint16_t DeviceCount)
+{
+  return ((uint32_t)DeviceCount + 7u) & ~7u;
+}
+
+
+static void
+Index_Start(PCA9534_Index_t *Index, uint64_t Time)
+{
+  Index->Block.Time = Time;
+  Index->Block.Changes = 0;
+  Index->Block.Reserved = 0;
+  memcpy(Index->Keyframe, Index->State, Index->Header.DeviceCount);
+}
+
+
+static PCA9534_Result_t
+Index_Flush(PCA9534_Index_t *Index)
+{
+  PCA9534_IndexEntry_t *Entries = NULL;
+  uint8_t Padding[8] = {0};
+  uint32_t KeyframeSize = Index_KeyframeSize(Index->Header.DeviceCount);
+  off_t Offset = ftello(Index->File);
+
+  if (Offset < 0)
+    return PCA9534_FAIL;
+
+  if (Index->Header.BlockCount == Index->EntriesSize)
+  {
+    Index->EntriesSize = Index->EntriesSize ? (Index->EntriesSize * 2) : 64;
+    Entries = realloc(Index->Entries,
+                      Index->EntriesSize * sizeof(PCA9534_IndexEntry_t));
+    if (!Entries)
+      return PCA9534_FAIL;
+    Index->Entries = Entries;
+  }
+
+  Index->Entries[Index->Header.BlockCount].Time = Index->Block.Time;
+  Index->Entries[Index->Header.BlockCount].Offset = (uint64_t)Offset;
+  Index->Header.BlockCount++;
+
+  if (fwrite(&Index->Block, sizeof(PCA9534_IndexBlock_t), 1,
+             Index->File) != 1 ||
+      fwrite(Index->Keyframe, 1, Index->Header.DeviceCount,
+             Index->File) != Index->Header.DeviceCount ||
+      fwrite(Padding, 1, KeyframeSize - Index->Header.DeviceCount,
+             Index->File) != KeyframeSize - Index->Header.DeviceCount)
+    return PCA9534_FAIL;
+
+  if (Index->Block.Changes &&
+      fwrite(Index->Changes, sizeof(PCA9534_IndexChange_t),
+             Index->Block.Changes, Index->File) != Index->Block.Changes)
+    return PCA9534_FAIL;
+
+  return PCA9534_OK;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Create an indexed capture file
+ * @param  Index: Pointer to writer
+ * @param  Path: Path of file
+ * @param  Devices: I2C address of each device
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @param  StartRealtime: CLOCK_REALTIME at the start of capture (ns)
+ * @param  StartMonotonic: CLOCK_MONOTONIC at the start of capture (ns)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to create the file or allocate memory.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Create(PCA9534_Index_t *Index, const char *Path,
+                     const uint8_t *Devices, uint16_t DeviceCount,
+                     uint64_t StartRealtime, uint64_t StartMonotonic)
+{
+  if (!Index || !Path || !Devices)
+    return PCA9534_INVALID_PARAM;
+
+  if (!DeviceCount || DeviceCount > PCA9534_CAPTURE_DEVICES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  memset(Index, 0, sizeof(PCA9534_Index_t));
+  Index->Fd = -1;
+  Index->Header.Magic = PCA9534_INDEX_MAGIC;
+  Index->Header.Version = PCA9534_INDEX_VERSION;
+  Index->Header.DeviceCount = DeviceCount;
+  Index->Header.StartRealtime = StartRealtime;
+  Index->Header.StartMonotonic = StartMonotonic;
+  memcpy(Index->Header.Devices, Devices, DeviceCount);
+
+  Index->Changes = malloc(PCA9534_INDEX_BLOCK_CHANGES *
+                          sizeof(PCA9534_IndexChange_t));
+  if (!Index->Changes)
+    return PCA9534_FAIL;
+
+  Index->File = fopen(Path, "wb");
+  if (!Index->File)
+  {
+    free(Index->Changes);
+    Index->Changes = NULL;
+    return PCA9534_FAIL;
+  }
+
+  // The header is written again with the final values on close
+  if (fwrite(&Index->Header, sizeof(PCA9534_IndexHeader_t), 1,
+             Index->File) != 1)
+  {
+    fclose(Index->File);
+    free(Index->Changes);
+    Index->File = NULL;
+    Index->Changes = NULL;
+    return PCA9534_FAIL;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Append one sample (only the devices that changed are stored)
+ * @param  Index: Pointer to writer
+ * @param  Time: Monotonic time of sample in ns (must not decrease)
+ * @param  Data: Input byte of each device
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Append(PCA9534_Index_t *Index, uint64_t Time,
+                     const uint8_t *Data)
+{
+  PCA9534_IndexChange_t *Change = NULL;
+  uint16_t d = 0;
+
+  if (!Index || !Index->File || !Data)
+    return PCA9534_INVALID_PARAM;
+
+  if (!Index->Started)
+  {
+    Index->Started = 1;
+    memcpy(Index->State, Data, Index->Header.DeviceCount);
+    Index_Start(Index, Time);
+    Index->Header.EndTime = Time;
+    return PCA9534_OK;
+  }
+
+  if (Time < Index->Header.EndTime)
+    return PCA9534_INVALID_PARAM;
+  Index->Header.EndTime = Time;
+
+  for (d = 0; d < Index->Header.DeviceCount; d++)
+  {
+    if (Data[d] == Index->State[d])
+      continue;
+
+    // New keyframe when the block is full or the delta does not fit
+    if (Index->Block.Changes == PCA9534_INDEX_BLOCK_CHANGES ||
+        Time - Index->Block.Time > UINT32_MAX)
+    {
+      if (Index_Flush(Index) != PCA9534_OK)
+        return PCA9534_FAIL;
+      Index_Start(Index, Time);
+    }
+
+    Change = &Index->Changes[Index->Block.Changes++];
+    Change->Delta = (uint32_t)(Time - Index->Block.Time);
+    Change->Device = d;
+    Change->Value = Data[d];
+    Change->Reserved = 0;
+    Index->State[d] = Data[d];
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Convert a ring capture into an indexed capture file
+ * @param  Capture: Pointer to capture session
+ * @param  Path: Path of file
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_FromCapture(const PCA9534_Capture_t *Capture, const char *Path)
+{
+  PCA9534_Index_t Index;
+  const uint8_t *Data = NULL;
+  uint64_t Count = 0;
+  uint64_t Time = 0;
+  uint64_t i = 0;
+
+  if (!Capture || !Capture->Header || !Path)
+    return PCA9534_INVALID_PARAM;
+
+  if (PCA9534_Index_Create(&Index, Path, Capture->Header->Devices,
+                           Capture->Header->DeviceCount,
+                           Capture->Header->StartRealtime,
+                           Capture->Header->StartMonotonic) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  Count = PCA9534_Capture_Count(Capture);
+  for (i = 0; i < Count; i++)
+  {
+    Data = PCA9534_Capture_Get(Capture, i, &Time);
+    if (PCA9534_Index_Append(&Index, Time, Data) != PCA9534_OK)
+    {
+      PCA9534_Index_Close(&Index);
+      return PCA9534_FAIL;
+    }
+  }
+
+  return PCA9534_Index_Close(&Index);
+}
+
+
+/**
+ * @brief  Open an indexed capture file and load its time index
+ * @param  Index: Pointer to reader
+ * @param  Path: Path of file
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read the file or the file is invalid.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Open(PCA9534_Index_t *Index, const char *Path)
+{
+  PCA9534_IndexHeader_t *Header = NULL;
+  size_t Size = 0;
+
+  if (!Index || !Path)
+    return PCA9534_INVALID_PARAM;
+
+  memset(Index, 0, sizeof(PCA9534_Index_t));
+  Header = &Index->Header;
+
+  Index->Fd = open(Path, O_RDONLY);
+  if (Index->Fd < 0)
+    return PCA9534_FAIL;
+
+  if (pread(Index->Fd, Header, sizeof(PCA9534_IndexHeader_t), 0) !=
+      (ssize_t)sizeof(PCA9534_IndexHeader_t) ||
+      Header->Magic != PCA9534_INDEX_MAGIC ||
+      Header->Version != PCA9534_INDEX_VERSION ||
+      !Header->DeviceCount ||
+      Header->DeviceCount > PCA9534_CAPTURE_DEVICES_MAX)
+  {
+    close(Index->Fd);
+    return PCA9534_FAIL;
+  }
+
+  Size = (size_t)Header->BlockCount * sizeof(PCA9534_IndexEntry_t);
+  Index->Entries = malloc(Size ? Size : 1);
+  Index->EntriesSize = Header->BlockCount;
+  Index->Changes = malloc(PCA9534_INDEX_BLOCK_CHANGES *
+                          sizeof(PCA9534_IndexChange_t));
+  if (!Index->Entries || !Index->Changes ||
+      pread(Index->Fd, Index->Entries, Size,
+            (off_t)Header->IndexOffset) != (ssize_t)Size)
+  {
+    PCA9534_Index_Close(Index);
+    return PCA9534_FAIL;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Input values of all devices at a point in time
+ * @note   Binary search of the time index, then one block read.
+ * @param  Index: Pointer to reader
+ * @param  Time: Monotonic time in ns
+ *         (see PCA9534_Index_Monotonic for wall-clock time)
+ * @param  Data: Pointer to DeviceCount bytes
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or Time is
+ *           before the first sample.
+ */
+PCA9534_Result_t
+PCA9534_Index_Query(PCA9534_Index_t *Index, uint64_t Time, uint8_t *Data)
+{
+  uint8_t Buffer[sizeof(PCA9534_IndexBlock_t) + PCA9534_CAPTURE_DEVICES_MAX];
+  const PCA9534_IndexHeader_t *Header = NULL;
+  PCA9534_IndexBlock_t Block;
+  uint32_t KeyframeSize = 0;
+  uint64_t Low = 0;
+  uint64_t High = 0;
+  uint64_t Mid = 0;
+  uint64_t End = 0;
+  uint64_t Offset = 0;
+  uint32_t Changes = 0;
+  uint32_t i = 0;
+
+  if (!Index || Index->Fd < 0 || !Data)
+    return PCA9534_INVALID_PARAM;
+
+  Header = &Index->Header;
+  if (!Header->BlockCount || Time < Index->Entries[0].Time)
+    return PCA9534_INVALID_PARAM;
+
+  // Last block whose keyframe is not after Time
+  Low = 0;
+  High = Header->BlockCount;
+  while (High - Low > 1)
+  {
+    Mid = Low + (High - Low) / 2;
+    if (Index->Entries[Mid].Time <= Time)
+      Low = Mid;
+    else
+      High = Mid;
+  }
+
+  Offset = Index->Entries[Low].Offset;
+  End = (Low + 1 < Header->BlockCount) ?
+        Index->Entries[Low + 1].Offset : Header->IndexOffset;
+  KeyframeSize = Index_KeyframeSize(Header->DeviceCount);
+
+  if (pread(Index->Fd, Buffer, sizeof(Block) + KeyframeSize, (off_t)Offset) !=
+      (ssize_t)(sizeof(Block) + KeyframeSize))
+    return PCA9534_FAIL;
+
+  memcpy(&Block, Buffer, sizeof(Block));
+  memcpy(Data, &Buffer[sizeof(Block)], Header->DeviceCount);
+
+  Changes = Block.Changes;
+  if (Changes > PCA9534_INDEX_BLOCK_CHANGES ||
+      Offset + sizeof(Block) + KeyframeSize +
+      Changes * sizeof(PCA9534_IndexChange_t) > End)
+    return PCA9534_FAIL;
+
+  if (Changes &&
+      pread(Index->Fd, Index->Changes, Changes * sizeof(PCA9534_IndexChange_t),
+            (off_t)(Offset + sizeof(Block) + KeyframeSize)) !=
+      (ssize_t)(Changes * sizeof(PCA9534_IndexChange_t)))
+    return PCA9534_FAIL;
+
+  for (i = 0; i < Changes; i++)
+  {
+    if (Block.Time + Index->Changes[i].Delta > Time)
+      break;
+    if (Index->Changes[i].Device < Header->DeviceCount)
+      Data[Index->Changes[i].Device] = Index->Changes[i].Value;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Convert wall-clock time to the monotonic time of the capture
+ * @param  Index: Pointer to reader
+ * @param  Realtime: CLOCK_REALTIME in ns
+ * @retval Monotonic time in ns
+ */
+uint64_t
+PCA9534_Index_Monotonic(const PCA9534_Index_t *Index, uint64_t Realtime)
+{
+  return Realtime - Index->Header.StartRealtime + Index->Header.StartMonotonic;
+}
+
+
+/**
+ * @brief  Close the file (the writer also writes the time index)
+ * @param  Index: Pointer to writer/reader
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Close(PCA9534_Index_t *Index)
+{
+  PCA9534_Result_t Result = PCA9534_OK;
+  off_t Offset = 0;
+
+  if (!Index)
+    return PCA9534_INVALID_PARAM;
+
+  if (Index->File)
+  {
+    if (Index->Started && Index_Flush(Index) != PCA9534_OK)
+      Result = PCA9534_FAIL;
+
+    Offset = ftello(Index->File);
+    if (Offset < 0)
+      Result = PCA9534_FAIL;
+    Index->Header.IndexOffset = (uint64_t)Offset;
+
+    if (Result == PCA9534_OK && Index->Header.BlockCount &&
+        fwrite(Index->Entries, sizeof(PCA9534_IndexEntry_t),
+               Index->Header.BlockCount,
+               Index->File) != Index->Header.BlockCount)
+      Result = PCA9534_FAIL;
+
+    if (Result == PCA9534_OK &&
+        (fseeko(Index->File, 0, SEEK_SET) != 0 ||
+         fwrite(&Index->Header, sizeof(PCA9534_IndexHeader_t), 1,
+                Index->File) != 1))
+      Result = PCA9534_FAIL;
+
+    if (fclose(Index->File) != 0)
+      Result = PCA9534_FAIL;
+    Index->File = NULL;
+  }
+
+  if (Index->Fd >= 0)
+  {
+    close(Index->Fd);
+    Index->Fd = -1;
+  }
+
+  free(Index->Entries);
+  free(Index->Changes);
+  Index->Entries = NULL;
+  Index->Changes = NULL;
+
+  return Result;
+}
@@ -0,0 +1,262 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_index.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Time-indexed capture container with keyframes and random seek
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_INDEX_H_
+#define _PCA9534_INDEX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_capture.h"
+#include <stdint.h>
+#include <stdio.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Maximum number of change records between two keyframes
+ */
+#define PCA9534_INDEX_BLOCK_CHANGES   4096
+
+
+
+/* Exported Constants -----------------------------------------------------------*/
+#define PCA9534_INDEX_MAGIC           0x58493950  // "P9IX"
+#define PCA9534_INDEX_VERSION         1
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  File header
+ * @note   File layout:
+ *         - Header
+ *         - Blocks: PCA9534_IndexBlock_t, the full state of all devices
+ *           (keyframe, padded to a multiple of 8 bytes), then Changes
+ *           PCA9534_IndexChange_t records in time order
+ *         - Index: BlockCount PCA9534_IndexEntry_t at IndexOffset
+ *         A block ends after PCA9534_INDEX_BLOCK_CHANGES changes or when the
+ *         time since its keyframe does not fit in 32 bits (about 4.29 s).
+ */
+typedef struct PCA9534_IndexHeader_s
+{
+  uint32_t Magic;
+  uint16_t Version;
+  uint16_t DeviceCount;
+  // CLOCK_REALTIME and CLOCK_MONOTONIC at the start of capture (ns)
+  uint64_t StartRealtime;
+  uint64_t StartMonotonic;
+  // Number of blocks and offset of the index
+  uint64_t BlockCount;
+  uint64_t IndexOffset;
+  // Time of the last sample (ns)
+  uint64_t EndTime;
+  // I2C address of each device
+  uint8_t Devices[PCA9534_CAPTURE_DEVICES_MAX];
+} PCA9534_IndexHeader_t;
+
+/**
+ * @brief  Block header (keyframe)
+ */
+typedef struct PCA9534_IndexBlock_s
+{
+  // Time of keyframe (ns)
+  uint64_t Time;
+  // Number of change records of the block
+  uint32_t Changes;
+  uint32_t Reserved;
+} PCA9534_IndexBlock_t;
+
+/**
+ * @brief  Change record (8 bytes)
+ */
+typedef struct PCA9534_IndexChange_s
+{
+  // Time since the keyframe of the block (ns)
+  uint32_t Delta;
+  // Index of device
+  uint16_t Device;
+  // New input value of the device
+  uint8_t Value;
+  uint8_t Reserved;
+} PCA9534_IndexChange_t;
+
+/**
+ * @brief  Sparse time index entry (one per block)
+ */
+typedef struct PCA9534_IndexEntry_s
+{
+  uint64_t Time;
+  uint64_t Offset;
+} PCA9534_IndexEntry_t;
+
+/**
+ * @brief  Writer/Reader data type
+ */
+typedef struct PCA9534_Index_s
+{
+  PCA9534_IndexHeader_t Header;
+
+  // Writer: output stream. Reader: file descriptor
+  FILE *File;
+  int Fd;
+
+  // Sparse time index
+  PCA9534_IndexEntry_t *Entries;
+  uint64_t EntriesSize;
+
+  // Writer: current block
+  PCA9534_IndexBlock_t Block;
+  uint8_t Keyframe[PCA9534_CAPTURE_DEVICES_MAX];
+  uint8_t State[PCA9534_CAPTURE_DEVICES_MAX];
+  PCA9534_IndexChange_t *Changes;
+
+  // Writer: 0 until the first sample
+  uint8_t Started;
+} PCA9534_Index_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Create an indexed capture file
+ * @param  Index: Pointer to writer
+ * @param  Path: Path of file
+ * @param  Devices: I2C address of each device
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @param  StartRealtime: CLOCK_REALTIME at the start of capture (ns)
+ * @param  StartMonotonic: CLOCK_MONOTONIC at the start of capture (ns)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to create the file or allocate memory.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Create(PCA9534_Index_t *Index, const char *Path,
+                     const uint8_t *Devices, uint16_t DeviceCount,
+                     uint64_t StartRealtime, uint64_t StartMonotonic);
+
+
+/**
+ * @brief  Append one sample (only the devices that changed are stored)
+ * @param  Index: Pointer to writer
+ * @param  Time: Monotonic time of sample in ns (must not decrease)
+ * @param  Data: Input byte of each device
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Append(PCA9534_Index_t *Index, uint64_t Time,
+                     const uint8_t *Data);
+
+
+/**
+ * @brief  Convert a ring capture into an indexed capture file
+ * @param  Capture: Pointer to capture session
+ * @param  Path: Path of file
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_FromCapture(const PCA9534_Capture_t *Capture, const char *Path);
+
+
+/**
+ * @brief  Open an indexed capture file and load its time index
+ * @param  Index: Pointer to reader
+ * @param  Path: Path of file
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read the file or the file is invalid.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Open(PCA9534_Index_t *Index, const char *Path);
+
+
+/**
+ * @brief  Input values of all devices at a point in time
+ * @note   Binary search of the time index, then one block read.
+ * @param  Index: Pointer to reader
+ * @param  Time: Monotonic time in ns
+ *         (see PCA9534_Index_Monotonic for wall-clock time)
+ * @param  Data: Pointer to DeviceCount bytes
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to read the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid or Time is
+ *           before the first sample.
+ */
+PCA9534_Result_t
+PCA9534_Index_Query(PCA9534_Index_t *Index, uint64_t Time, uint8_t *Data);
+
+
+/**
+ * @brief  Convert wall-clock time to the monotonic time of the capture
+ * @param  Index: Pointer to reader
+ * @param  Realtime: CLOCK_REALTIME in ns
+ * @retval Monotonic time in ns
+ */
+uint64_t
+PCA9534_Index_Monotonic(const PCA9534_Index_t *Index, uint64_t Realtime);
+
+
+/**
+ * @brief  Close the file (the writer also writes the time index)
+ * @param  Index: Pointer to writer/reader
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the file.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Index_Close(PCA9534_Index_t *Index);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_INDEX_H_
@@ -0,0 +1,236 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_transpose.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Bit-plane transposition of captured input samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_transpose.h"
+#include <string.h>
+#if PCA9534_TRANSPOSE_SIMD && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Samples gathered from a capture per transposition step
+#define PCA9534_TRANSPOSE_CHUNK   4096
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint64_t
+Transpose_Load64(const uint8_t *Data)
+{
+  return ((uint64_t)Data[0])       | ((uint64_t)Data[1] << 8)  |
+         ((uint64_t)Data[2] << 16) | ((uint64_t)Data[3] << 24) |
+         ((uint64_t)Data[4] << 32) | ((uint64_t)Data[5] << 40) |
+         ((uint64_t)Data[6] << 48) | ((uint64_t)Data[7] << 56);
+}
+
+
+/**
+ * @brief  Transpose 8 samples: gather bit p of every byte with one multiply
+ */
+static void
+Transpose_8(const uint8_t *Samples, uint8_t *Planes, uint64_t Stride)
+{
+  uint64_t x = Transpose_Load64(Samples);
+  uint8_t p = 0;
+
+  for (p = 0; p < 8; p++)
+  {
+    Planes[p * Stride] =
+      (uint8_t)((((x >> p) & 0x0101010101010101ull) *
+                 0x0102040810204080ull) >> 56);
+  }
+}
+
+
+static void
+Transpose_Tail(const uint8_t *Samples, uint64_t Count,
+               uint8_t *Planes, uint64_t Stride)
+{
+  uint8_t Buffer[8] = {0};
+
+  if (!Count)
+    return;
+
+  memcpy(Buffer, Samples, (size_t)Count);
+  Transpose_8(Buffer, Planes, Stride);
+}
+
+
+#if PCA9534_TRANSPOSE_SIMD && defined(__AVX2__)
+/**
+ * @brief  Transpose 32 samples: movemask takes bit 7 of every byte, then the
+ *         bytes are shifted left by one for the next plane
+ */
+static void
+Transpose_32(const uint8_t *Samples, uint8_t *Planes, uint64_t Stride)
+{
+  __m256i x = _mm256_loadu_si256((const __m256i *)Samples);
+  uint32_t Mask = 0;
+  int p = 0;
+
+  for (p = 7; p >= 0; p--)
+  {
+    Mask = (uint32_t)_mm256_movemask_epi8(x);
+    memcpy(&Planes[p * Stride], &Mask, sizeof(Mask));
+    x = _mm256_add_epi8(x, x);
+  }
+}
+#elif PCA9534_TRANSPOSE_SIMD && defined(__SSE2__)
+/**
+ * @brief  Transpose 16 samples: movemask takes bit 7 of every byte, then the
+ *         bytes are shifted left by one for the next plane
+ */
+static void
+Transpose_16(const uint8_t *Samples, uint8_t *Planes, uint64_t Stride)
+{
+  __m128i x = _mm_loadu_si128((const __m128i *)Samples);
+  uint16_t Mask = 0;
+  int p = 0;
+
+  for (p = 7; p >= 0; p--)
+  {
+    Mask = (uint16_t)_mm_movemask_epi8(x);
+    memcpy(&Planes[p * Stride], &Mask, sizeof(Mask));
+    x = _mm_add_epi8(x, x);
+  }
+}
+#endif
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Transpose 8-bit samples into 8 per-pin bit-planes
+ * @note   Bit (i % 8) of byte (i / 8) of plane p is bit p of sample i. Unused
+ *         bits of the last byte are cleared. Uses the widest kernel enabled at
+ *         compile time (AVX2: 32 samples, SSE2: 16 samples per step).
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @param  Planes: Pointer to output, plane p starts at Planes + p * Stride
+ * @param  Stride: Bytes between planes (Stride >= (Count + 7) / 8)
+ * @retval None
+ */
+void
+PCA9534_Transpose(const uint8_t *Samples, uint64_t Count,
+                  uint8_t *Planes, uint64_t Stride)
+{
+  uint64_t i = 0;
+
+#if PCA9534_TRANSPOSE_SIMD && defined(__AVX2__)
+  for (; i + 32 <= Count; i += 32)
+    Transpose_32(&Samples[i], &Planes[i / 8], Stride);
+#elif PCA9534_TRANSPOSE_SIMD && defined(__SSE2__)
+  for (; i + 16 <= Count; i += 16)
+    Transpose_16(&Samples[i], &Planes[i / 8], Stride);
+#endif
+
+  PCA9534_Transpose_Scalar(&Samples[i], Count - i, &Planes[i / 8], Stride);
+}
+
+
+/**
+ * @brief  Portable version of PCA9534_Transpose (8x8 bit-matrix per step)
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @param  Planes: Pointer to output, plane p starts at Planes + p * Stride
+ * @param  Stride: Bytes between planes (Stride >= (Count + 7) / 8)
+ * @retval None
+ */
+void
+PCA9534_Transpose_Scalar(const uint8_t *Samples, uint64_t Count,
+                         uint8_t *Planes, uint64_t Stride)
+{
+  uint64_t i = 0;
+
+  for (; i + 8 <= Count; i += 8)
+    Transpose_8(&Samples[i], &Planes[i / 8], Stride);
+
+  Transpose_Tail(&Samples[i], Count - i, &Planes[i / 8], Stride);
+}
+
+
+/**
+ * @brief  Transpose the samples of one device of a capture into bit-planes
+ * @param  Capture: Pointer to capture session
+ * @param  Device: Index of device in capture
+ * @param  First: Index of first record
+ * @param  Count: Number of records
+ * @param  Planes: Pointer to output, plane p starts at Planes + p * Stride
+ * @param  Stride: Bytes between planes (Stride >= (Count + 7) / 8)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transpose_Capture(const PCA9534_Capture_t *Capture, uint16_t Device,
+                          uint64_t First, uint64_t Count,
+                          uint8_t *Planes, uint64_t Stride)
+{
+  uint8_t Buffer[PCA9534_TRANSPOSE_CHUNK];
+  uint64_t Done = 0;
+  uint64_t Len = 0;
+  uint64_t i = 0;
+
+  if (!Capture || !Capture->Header || !Planes)
+    return PCA9534_INVALID_PARAM;
+
+  if (Device >= Capture->Header->DeviceCount || Stride < (Count + 7) / 8)
+    return PCA9534_INVALID_PARAM;
+
+  if (First + Count > PCA9534_Capture_Count(Capture))
+    return PCA9534_INVALID_PARAM;
+
+  // The chunk size is a multiple of 8, so every chunk starts on a plane byte
+  for (Done = 0; Done < Count; Done += Len)
+  {
+    Len = Count - Done;
+    if (Len > PCA9534_TRANSPOSE_CHUNK)
+      Len = PCA9534_TRANSPOSE_CHUNK;
+
+    for (i = 0; i < Len; i++)
+      Buffer[i] = PCA9534_Capture_Get(Capture, First + Done + i, NULL)[Device];
+
+    PCA9534_Transpose(Buffer, Len, &Planes[Done / 8], Stride);
+  }
+
+  return PCA9534_OK;
+}
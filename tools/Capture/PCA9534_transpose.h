@@ -0,0 +1,114 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_transpose.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Bit-plane transposition of captured input samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_TRANSPOSE_H_
+#define _PCA9534_TRANSPOSE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_capture.h"
+#include <stdint.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Use SSE2/AVX2 kernels when the compiler targets them
+ * @note   Set it to 0 to force the portable kernel.
+ */
+#ifndef PCA9534_TRANSPOSE_SIMD
+#define PCA9534_TRANSPOSE_SIMD  1
+#endif
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Transpose 8-bit samples into 8 per-pin bit-planes
+ * @note   Bit (i % 8) of byte (i / 8) of plane p is bit p of sample i. Unused
+ *         bits of the last byte are cleared. Uses the widest kernel enabled at
+ *         compile time (AVX2: 32 samples, SSE2: 16 samples per step).
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @param  Planes: Pointer to output, plane p starts at Planes + p * Stride
+ * @param  Stride: Bytes between planes (Stride >= (Count + 7) / 8)
+ * @retval None
+ */
+void
+PCA9534_Transpose(const uint8_t *Samples, uint64_t Count,
+                  uint8_t *Planes, uint64_t Stride);
+
+
+/**
+ * @brief  Portable version of PCA9534_Transpose (8x8 bit-matrix per step)
+ * @param  Samples: Pointer to samples
+ * @param  Count: Number of samples
+ * @param  Planes: Pointer to output, plane p starts at Planes + p * Stride
+ * @param  Stride: Bytes between planes (Stride >= (Count + 7) / 8)
+ * @retval None
+ */
+void
+PCA9534_Transpose_Scalar(const uint8_t *Samples, uint64_t Count,
+                         uint8_t *Planes, uint64_t Stride);
+
+
+/**
+ * @brief  Transpose the samples of one device of a capture into bit-planes
+ * @param  Capture: Pointer to capture session
+ * @param  Device: Index of device in capture
+ * @param  First: Index of first record
+ * @param  Count: Number of records
+ * @param  Planes: Pointer to output, plane p starts at Planes + p * Stride
+ * @param  Stride: Bytes between planes (Stride >= (Count + 7) / 8)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Transpose_Capture(const PCA9534_Capture_t *Capture, uint16_t Device,
+                          uint64_t First, uint64_t Count,
+                          uint8_t *Planes, uint64_t Stride);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_TRANSPOSE_H_
@@ -0,0 +1,247 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_transpose_bench.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Scalar vs SIMD bit-plane transpose benchmark
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/**
+ * Usage: PCA9534_transpose_bench [capture-file [device]]
+ *
+ * Transposes the samples of one device of a capture with the SIMD and the
+ * portable kernels, checks that the planes are the same and prints the
+ * throughput of both. Without a capture file, a synthetic capture of
+ * PCA9534_BENCH_SAMPLES samples is taken from a simulated bus.
+ *
+ * Build:
+ *   cc -O2 -march=native -Isrc/include -Itools/Capture \
+ *      tools/Capture/PCA9534_transpose_bench.c tools/Capture/PCA9534_transpose.c \
+ *      tools/Capture/PCA9534_capture.c src/PCA9534.c
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include "PCA9534_transpose.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Samples of the synthetic capture
+#define PCA9534_BENCH_SAMPLES   (1u << 22)
+
+// Passes of each kernel
+#define PCA9534_BENCH_PASSES    16
+
+// Path of the synthetic capture
+#define PCA9534_BENCH_PATH      "/tmp/PCA9534_transpose_bench.cap"
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+// Simulated input port and PRNG state
+static uint8_t Bench_Input = 0x00;
+static uint32_t Bench_Seed = 1;
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint64_t
+Bench_Now(void)
+{
+  struct timespec Ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &Ts);
+  return (uint64_t)Ts.tv_sec * 1000000000ull + (uint64_t)Ts.tv_nsec;
+}
+
+
+static int8_t
+Bench_Send(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  (void)Address;
+  (void)Data;
+  (void)DataLen;
+  return 0;
+}
+
+
+// Input port with a pin toggling in about one of 16 reads
+static int8_t
+Bench_Receive(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  uint8_t i = 0;
+
+  (void)Address;
+  Bench_Seed = Bench_Seed * 1103515245u + 12345u;
+  if (((Bench_Seed >> 16) & 0x0F) == 0)
+    Bench_Input ^= (uint8_t)(1u << ((Bench_Seed >> 20) & 0x07));
+
+  for (i = 0; i < DataLen; i++)
+    Data[i] = Bench_Input;
+
+  return 0;
+}
+
+
+static int
+Bench_Synthesize(PCA9534_Capture_t *Capture)
+{
+  static PCA9534_Handler_t Handler;
+  PCA9534_Handler_t *Handlers[1] = {&Handler};
+
+  PCA9534_PLATFORM_LINK_SEND(&Handler, Bench_Send);
+  PCA9534_PLATFORM_LINK_RECEIVE(&Handler, Bench_Receive);
+  if (PCA9534_Init(&Handler, PCA9534_DEVICE_PCA9534, 0) != PCA9534_OK)
+    return -1;
+
+  if (PCA9534_Capture_Create(Capture, PCA9534_BENCH_PATH, Handlers, 1,
+                             PCA9534_BENCH_SAMPLES) != PCA9534_OK)
+    return -1;
+
+  if (PCA9534_Capture_Run(Capture, PCA9534_BENCH_SAMPLES, NULL) != PCA9534_OK)
+    return -1;
+
+  return 0;
+}
+
+
+// Best time of PCA9534_BENCH_PASSES passes in ns
+static uint64_t
+Bench_Time(void (*Kernel)(const uint8_t *, uint64_t, uint8_t *, uint64_t),
+           const uint8_t *Samples, uint64_t Count,
+           uint8_t *Planes, uint64_t Stride)
+{
+  uint64_t Best = UINT64_MAX;
+  uint64_t Start = 0;
+  uint32_t Pass = 0;
+
+  for (Pass = 0; Pass < PCA9534_BENCH_PASSES; Pass++)
+  {
+    Start = Bench_Now();
+    Kernel(Samples, Count, Planes, Stride);
+    Start = Bench_Now() - Start;
+    if (Start < Best)
+      Best = Start;
+  }
+
+  return Best ? Best : 1;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+int
+main(int argc, char **argv)
+{
+  PCA9534_Capture_t Capture;
+  uint8_t *Samples = NULL;
+  uint8_t *PlanesSimd = NULL;
+  uint8_t *PlanesScalar = NULL;
+  uint64_t Count = 0;
+  uint64_t Stride = 0;
+  uint64_t TimeSimd = 0;
+  uint64_t TimeScalar = 0;
+  uint64_t i = 0;
+  uint16_t Device = 0;
+  int Same = 0;
+
+  if (argc > 1)
+  {
+    if (PCA9534_Capture_Open(&Capture, argv[1]) != PCA9534_OK)
+    {
+      fprintf(stderr, "Can not open capture %s\n", argv[1]);
+      return 1;
+    }
+    if (argc > 2)
+      Device = (uint16_t)atoi(argv[2]);
+  }
+  else if (Bench_Synthesize(&Capture) != 0)
+  {
+    fprintf(stderr, "Can not create synthetic capture\n");
+    return 1;
+  }
+
+  if (Device >= Capture.Header->DeviceCount)
+  {
+    fprintf(stderr, "Capture has %u devices\n", Capture.Header->DeviceCount);
+    return 1;
+  }
+
+  Count = PCA9534_Capture_Count(&Capture);
+  Stride = (Count + 7) / 8;
+  Samples = malloc(Count ? Count : 1);
+  PlanesSimd = calloc(8, Stride ? Stride : 1);
+  PlanesScalar = calloc(8, Stride ? Stride : 1);
+  if (!Samples || !PlanesSimd || !PlanesScalar)
+  {
+    fprintf(stderr, "Out of memory\n");
+    return 1;
+  }
+
+  for (i = 0; i < Count; i++)
+    Samples[i] = PCA9534_Capture_Get(&Capture, i, NULL)[Device];
+
+  TimeSimd = Bench_Time(PCA9534_Transpose, Samples, Count,
+                        PlanesSimd, Stride);
+  TimeScalar = Bench_Time(PCA9534_Transpose_Scalar, Samples, Count,
+                          PlanesScalar, Stride);
+  Same = (memcmp(PlanesSimd, PlanesScalar, 8 * Stride) == 0);
+
+#if PCA9534_TRANSPOSE_SIMD && defined(__AVX2__)
+  printf("kernel:  AVX2\n");
+#elif PCA9534_TRANSPOSE_SIMD && defined(__SSE2__)
+  printf("kernel:  SSE2\n");
+#else
+  printf("kernel:  portable\n");
+#endif
+  printf("samples: %llu (device %u)\n", (unsigned long long)Count, Device);
+  printf("simd:    %8.1f Msamples/s\n", Count * 1e3 / TimeSimd);
+  printf("scalar:  %8.1f Msamples/s\n", Count * 1e3 / TimeScalar);
+  printf("speedup: %8.2fx\n", (double)TimeScalar / TimeSimd);
+  printf("planes:  %s\n", Same ? "same" : "DIFFERENT");
+
+  free(Samples);
+  free(PlanesSimd);
+  free(PlanesScalar);
+  PCA9534_Capture_Close(&Capture);
+  if (argc <= 1)
+    remove(PCA9534_BENCH_PATH);
+
+  return Same ? 0 : 2;
+}
@@ -0,0 +1,302 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_trigger.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Pattern/edge trigger engine for capture sessions
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include "PCA9534_trigger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint8_t
+Trigger_Hit(const PCA9534_TriggerStage_t *Stage, uint8_t Value, uint8_t Prev)
+{
+  uint8_t Edges = (uint8_t)((~Prev & Value & Stage->Rise) |
+                            (Prev & ~Value & Stage->Fall));
+  uint8_t NoEdge = (uint8_t)((Stage->Rise | Stage->Fall) == 0);
+  uint8_t Match = (uint8_t)(((Value ^ Stage->Pattern) & Stage->Mask) == 0);
+
+  return Match & ((Edges != 0) | NoEdge);
+}
+
+
+static void
+Trigger_Push(PCA9534_Trigger_t *Trigger, uint64_t Time, const uint8_t *Data)
+{
+  uint8_t *Record = NULL;
+
+  if (!Trigger->Pre)
+    return;
+
+  Record = &Trigger->History[(size_t)Trigger->Head * Trigger->RecordSize];
+  memcpy(Record, &Time, sizeof(Time));
+  memcpy(Record + sizeof(Time), Data, Trigger->DeviceCount);
+
+  Trigger->Head = (Trigger->Head + 1) % Trigger->Pre;
+  if (Trigger->Used < Trigger->Pre)
+    Trigger->Used++;
+}
+
+
+static void
+Trigger_Flush(PCA9534_Trigger_t *Trigger)
+{
+  const uint8_t *Record = NULL;
+  uint64_t Time = 0;
+  uint32_t Oldest = 0;
+  uint32_t i = 0;
+
+  if (!Trigger->Pre)
+    return;
+
+  Oldest = (Trigger->Head + Trigger->Pre - Trigger->Used) % Trigger->Pre;
+  for (i = 0; i < Trigger->Used; i++)
+  {
+    Record = &Trigger->History[(size_t)((Oldest + i) % Trigger->Pre) *
+                               Trigger->RecordSize];
+    memcpy(&Time, Record, sizeof(Time));
+    Trigger->Sink(Trigger->Context, Time, Record + sizeof(Time));
+  }
+
+  Trigger->Head = 0;
+  Trigger->Used = 0;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize and arm the trigger
+ * @param  Trigger: Pointer to trigger
+ * @param  Stages: Pointer to stages, hit in order
+ * @param  StageCount: Number of stages (1 <= StageCount <= PCA9534_TRIGGER_STAGES_MAX)
+ * @param  DeviceCount: Number of devices of each sample
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @param  Pre: Number of samples kept before the trigger
+ * @param  Post: Number of samples kept after the trigger
+ * @param  Rearm: 1 to arm again after the post-trigger window
+ * @param  Sink: Function that persists the samples of windows
+ * @param  Window: Function that persists the header of each window, called
+ *                 before its first sample, so windows can be split apart
+ *                 again (can be NULL)
+ * @param  Context: User pointer passed to Sink and Window
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to allocate memory.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Trigger_Init(PCA9534_Trigger_t *Trigger,
+                     const PCA9534_TriggerStage_t *Stages, uint8_t StageCount,
+                     uint16_t DeviceCount, uint32_t Pre, uint32_t Post,
+                     uint8_t Rearm, PCA9534_Trigger_Sink_t Sink,
+                     PCA9534_Trigger_Window_t Window, void *Context)
+{
+  uint8_t i = 0;
+
+  if (!Trigger || !Stages || !Sink)
+    return PCA9534_INVALID_PARAM;
+
+  if (!StageCount || StageCount > PCA9534_TRIGGER_STAGES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  if (!DeviceCount || DeviceCount > PCA9534_CAPTURE_DEVICES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < StageCount; i++)
+  {
+    if (Stages[i].Device >= DeviceCount)
+      return PCA9534_INVALID_PARAM;
+  }
+
+  memset(Trigger, 0, sizeof(PCA9534_Trigger_t));
+  memcpy(Trigger->Stages, Stages, StageCount * sizeof(PCA9534_TriggerStage_t));
+  Trigger->StageCount = StageCount;
+  Trigger->State = PCA9534_TRIGGER_ARMED;
+  Trigger->Rearm = Rearm;
+  Trigger->DeviceCount = DeviceCount;
+  Trigger->RecordSize = sizeof(uint64_t) + DeviceCount;
+  Trigger->Pre = Pre;
+  Trigger->Post = Post;
+  Trigger->Sink = Sink;
+  Trigger->Window = Window;
+  Trigger->Context = Context;
+
+  if (Pre)
+  {
+    Trigger->History = malloc((size_t)Pre * Trigger->RecordSize);
+    if (!Trigger->History)
+      return PCA9534_FAIL;
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Free the pre-trigger ring
+ * @param  Trigger: Pointer to trigger
+ * @retval None
+ */
+void
+PCA9534_Trigger_DeInit(PCA9534_Trigger_t *Trigger)
+{
+  if (!Trigger)
+    return;
+
+  free(Trigger->History);
+  Trigger->History = NULL;
+  Trigger->Pre = 0;
+}
+
+
+/**
+ * @brief  Feed one sample to the trigger
+ * @param  Trigger: Pointer to trigger
+ * @param  Time: Time of sample in ns
+ * @param  Data: Input byte of each device
+ * @retval 1 if the trigger fired on this sample, otherwise 0
+ */
+uint8_t
+PCA9534_Trigger_Feed(PCA9534_Trigger_t *Trigger, uint64_t Time,
+                     const uint8_t *Data)
+{
+  const PCA9534_TriggerStage_t *Stage = NULL;
+  PCA9534_TriggerWindow_t Window;
+  uint8_t Fired = 0;
+
+  if (!Trigger->Started)
+  {
+    Trigger->Started = 1;
+    memcpy(Trigger->Prev, Data, Trigger->DeviceCount);
+  }
+
+  switch (Trigger->State)
+  {
+  case PCA9534_TRIGGER_ARMED:
+    Stage = &Trigger->Stages[Trigger->Stage];
+    Trigger->Stage += Trigger_Hit(Stage, Data[Stage->Device],
+                                  Trigger->Prev[Stage->Device]);
+    if (Trigger->Stage < Trigger->StageCount)
+    {
+      Trigger_Push(Trigger, Time, Data);
+      break;
+    }
+
+    Fired = 1;
+    Trigger->Stage = 0;
+    if (Trigger->Window)
+    {
+      Window.Index = Trigger->Triggers;
+      Window.Time = Time;
+      Window.Pre = Trigger->Used;
+      Window.Post = Trigger->Post;
+      Trigger->Window(Trigger->Context, &Window);
+    }
+    Trigger->Triggers++;
+    Trigger_Flush(Trigger);
+    Trigger->Sink(Trigger->Context, Time, Data);
+    Trigger->PostLeft = Trigger->Post;
+    if (Trigger->PostLeft)
+      Trigger->State = PCA9534_TRIGGER_POST;
+    else if (!Trigger->Rearm)
+      Trigger->State = PCA9534_TRIGGER_DONE;
+    break;
+
+  case PCA9534_TRIGGER_POST:
+    Trigger->Sink(Trigger->Context, Time, Data);
+    if (--Trigger->PostLeft == 0)
+      Trigger->State = Trigger->Rearm ?
+                       PCA9534_TRIGGER_ARMED : PCA9534_TRIGGER_DONE;
+    break;
+
+  default:
+    break;
+  }
+
+  memcpy(Trigger->Prev, Data, Trigger->DeviceCount);
+  return Fired;
+}
+
+
+/**
+ * @brief  Poll devices at the maximum bus rate and feed the trigger
+ * @note   Only the windows around triggers reach the sink.
+ * @param  Trigger: Pointer to trigger
+ * @param  Handlers: Array of pointers to DeviceCount initialized handlers
+ * @param  Samples: Maximum number of samples
+ * @param  Stop: Pointer to a flag that stops polling when set (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Trigger_Run(PCA9534_Trigger_t *Trigger, PCA9534_Handler_t **Handlers,
+                    uint64_t Samples, volatile int *Stop)
+{
+  uint8_t Data[PCA9534_CAPTURE_DEVICES_MAX] = {0};
+  struct timespec Ts;
+  uint64_t i = 0;
+  uint16_t d = 0;
+
+  if (!Trigger || !Handlers)
+    return PCA9534_INVALID_PARAM;
+
+  for (i = 0; i < Samples; i++)
+  {
+    if ((Stop && *Stop) || Trigger->State == PCA9534_TRIGGER_DONE)
+      break;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+
+    // A failed read keeps the previous value of the device
+    for (d = 0; d < Trigger->DeviceCount; d++)
+      PCA9534_Read(Handlers[d], &Data[d]);
+
+    PCA9534_Trigger_Feed(Trigger,
+                         (uint64_t)Ts.tv_sec * 1000000000ull +
+                         (uint64_t)Ts.tv_nsec, Data);
+  }
+
+  return PCA9534_OK;
+}
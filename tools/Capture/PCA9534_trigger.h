@@ -0,0 +1,231 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_trigger.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Pattern/edge trigger engine for capture sessions
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_TRIGGER_H_
+#define _PCA9534_TRIGGER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_capture.h"
+#include <stdint.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Maximum number of stages of a sequence trigger
+ */
+#define PCA9534_TRIGGER_STAGES_MAX  8
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Trigger stage
+ * @note   A stage hits on a sample when the pins in Mask equal Pattern and,
+ *         if Rise or Fall is not 0, at least one pin in Rise went high or one
+ *         pin in Fall went low since the previous sample.
+ *         - Pattern match: Mask/Pattern, Rise = Fall = 0
+ *         - Edge on a mask: Mask = 0, Rise and/or Fall
+ *         - Sequence of states: one stage per state
+ */
+typedef struct PCA9534_TriggerStage_s
+{
+  // Index of device in the sample
+  uint16_t Device;
+  uint8_t Mask;
+  uint8_t Pattern;
+  uint8_t Rise;
+  uint8_t Fall;
+} PCA9534_TriggerStage_t;
+
+/**
+ * @brief  Function type for persisting the samples around a trigger
+ * @param  Context: User pointer given to PCA9534_Trigger_Init
+ * @param  Time: Time of sample in ns
+ * @param  Data: Input byte of each device
+ */
+typedef void (*PCA9534_Trigger_Sink_t)(void *Context, uint64_t Time,
+                                       const uint8_t *Data);
+
+/**
+ * @brief  Window header, reported before the samples of each window
+ * @note   The sink then gets Pre samples, the trigger sample and up to Post
+ *         samples (fewer if polling stops before the window is complete).
+ */
+typedef struct PCA9534_TriggerWindow_s
+{
+  // Index of trigger (0 for the first one)
+  uint64_t Index;
+  // Time of the trigger sample in ns
+  uint64_t Time;
+  // Number of samples before the trigger sample
+  uint32_t Pre;
+  // Number of samples after the trigger sample
+  uint32_t Post;
+} PCA9534_TriggerWindow_t;
+
+/**
+ * @brief  Function type for persisting the header of a window
+ * @param  Context: User pointer given to PCA9534_Trigger_Init
+ * @param  Window: Pointer to window header
+ */
+typedef void (*PCA9534_Trigger_Window_t)(void *Context,
+                                         const PCA9534_TriggerWindow_t *Window);
+
+/**
+ * @brief  Trigger state
+ */
+typedef enum PCA9534_TriggerState_e
+{
+  PCA9534_TRIGGER_ARMED = 0,
+  PCA9534_TRIGGER_POST  = 1,
+  PCA9534_TRIGGER_DONE  = 2,
+} PCA9534_TriggerState_t;
+
+/**
+ * @brief  Trigger data type
+ */
+typedef struct PCA9534_Trigger_s
+{
+  PCA9534_TriggerStage_t Stages[PCA9534_TRIGGER_STAGES_MAX];
+  uint8_t StageCount;
+  // Next stage to hit
+  uint8_t Stage;
+
+  PCA9534_TriggerState_t State;
+  // Arm again after the post-trigger window
+  uint8_t Rearm;
+  // Number of triggers
+  uint64_t Triggers;
+
+  uint16_t DeviceCount;
+  uint8_t Started;
+  uint8_t Prev[PCA9534_CAPTURE_DEVICES_MAX];
+
+  // Pre-trigger ring: records of time (8 Bytes) and DeviceCount bytes
+  uint8_t *History;
+  uint32_t RecordSize;
+  uint32_t Pre;
+  uint32_t Head;
+  uint32_t Used;
+
+  // Post-trigger window
+  uint32_t Post;
+  uint32_t PostLeft;
+
+  PCA9534_Trigger_Sink_t Sink;
+  PCA9534_Trigger_Window_t Window;
+  void *Context;
+} PCA9534_Trigger_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize and arm the trigger
+ * @param  Trigger: Pointer to trigger
+ * @param  Stages: Pointer to stages, hit in order
+ * @param  StageCount: Number of stages (1 <= StageCount <= PCA9534_TRIGGER_STAGES_MAX)
+ * @param  DeviceCount: Number of devices of each sample
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @param  Pre: Number of samples kept before the trigger
+ * @param  Post: Number of samples kept after the trigger
+ * @param  Rearm: 1 to arm again after the post-trigger window
+ * @param  Sink: Function that persists the samples of windows
+ * @param  Window: Function that persists the header of each window, called
+ *                 before its first sample, so windows can be split apart
+ *                 again (can be NULL)
+ * @param  Context: User pointer passed to Sink and Window
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to allocate memory.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Trigger_Init(PCA9534_Trigger_t *Trigger,
+                     const PCA9534_TriggerStage_t *Stages, uint8_t StageCount,
+                     uint16_t DeviceCount, uint32_t Pre, uint32_t Post,
+                     uint8_t Rearm, PCA9534_Trigger_Sink_t Sink,
+                     PCA9534_Trigger_Window_t Window, void *Context);
+
+
+/**
+ * @brief  Free the pre-trigger ring
+ * @param  Trigger: Pointer to trigger
+ * @retval None
+ */
+void
+PCA9534_Trigger_DeInit(PCA9534_Trigger_t *Trigger);
+
+
+/**
+ * @brief  Feed one sample to the trigger
+ * @param  Trigger: Pointer to trigger
+ * @param  Time: Time of sample in ns
+ * @param  Data: Input byte of each device
+ * @retval 1 if the trigger fired on this sample, otherwise 0
+ */
+uint8_t
+PCA9534_Trigger_Feed(PCA9534_Trigger_t *Trigger, uint64_t Time,
+                     const uint8_t *Data);
+
+
+/**
+ * @brief  Poll devices at the maximum bus rate and feed the trigger
+ * @note   Only the windows around triggers reach the sink.
+ * @param  Trigger: Pointer to trigger
+ * @param  Handlers: Array of pointers to DeviceCount initialized handlers
+ * @param  Samples: Maximum number of samples
+ * @param  Stop: Pointer to a flag that stops polling when set (can be NULL)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Trigger_Run(PCA9534_Trigger_t *Trigger, PCA9534_Handler_t **Handlers,
+                    uint64_t Samples, volatile int *Stop);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_TRIGGER_H_
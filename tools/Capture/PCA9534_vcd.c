@@ -0,0 +1,263 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_vcd.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Value Change Dump export of captured pin activity
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_vcd.h"
+#include <string.h>
+#include <inttypes.h>
+
+
+/* Private Constants ------------------------------------------------------------*/
+// VCD identifiers use the printable characters '!' to '~'
+#define PCA9534_VCD_ID_FIRST  '!'
+#define PCA9534_VCD_ID_BASE   94
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static void
+Vcd_Id(uint16_t Signal, char *Id)
+{
+  uint8_t Len = 0;
+
+  do
+  {
+    Id[Len++] = (char)(PCA9534_VCD_ID_FIRST + (Signal % PCA9534_VCD_ID_BASE));
+    Signal /= PCA9534_VCD_ID_BASE;
+  } while (Signal);
+  Id[Len] = '\0';
+}
+
+
+static int
+Vcd_Pins(PCA9534_Vcd_t *Vcd, uint16_t Device, uint8_t Data, uint8_t Mask)
+{
+  char Id[4];
+  uint8_t Pin = 0;
+
+  for (Pin = 0; Mask; Pin++, Mask >>= 1)
+  {
+    if (!(Mask & 0x01))
+      continue;
+
+    Vcd_Id((uint16_t)(Device * 8 + Pin), Id);
+    if (fprintf(Vcd->File, "%c%s\n", ((Data >> Pin) & 0x01) ? '1' : '0',
+                Id) < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Write the VCD header
+ * @note   Device n is dumped as module "dev<n>_0x<address>" with one wire per
+ *         pin named "P0" to "P7". Time unit is 1 ns.
+ * @param  Vcd: Pointer to VCD writer
+ * @param  File: Output stream
+ * @param  Devices: I2C address of each device
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_Begin(PCA9534_Vcd_t *Vcd, FILE *File, const uint8_t *Devices,
+                  uint16_t DeviceCount)
+{
+  char Id[4];
+  uint16_t i = 0;
+  uint8_t Pin = 0;
+
+  if (!Vcd || !File || !Devices)
+    return PCA9534_INVALID_PARAM;
+
+  if (!DeviceCount || DeviceCount > PCA9534_CAPTURE_DEVICES_MAX)
+    return PCA9534_INVALID_PARAM;
+
+  memset(Vcd, 0, sizeof(PCA9534_Vcd_t));
+  Vcd->File = File;
+  Vcd->DeviceCount = DeviceCount;
+
+  fprintf(File, "$version PCA9534 capture $end\n");
+  fprintf(File, "$timescale 1ns $end\n");
+  fprintf(File, "$scope module pca9534 $end\n");
+  for (i = 0; i < DeviceCount; i++)
+  {
+    fprintf(File, "$scope module dev%u_0x%02X $end\n", i, Devices[i]);
+    for (Pin = 0; Pin < 8; Pin++)
+    {
+      Vcd_Id((uint16_t)(i * 8 + Pin), Id);
+      fprintf(File, "$var wire 1 %s P%u $end\n", Id, Pin);
+    }
+    fprintf(File, "$upscope $end\n");
+  }
+  fprintf(File, "$upscope $end\n");
+  if (fprintf(File, "$enddefinitions $end\n") < 0)
+    return PCA9534_FAIL;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Write one sample (only the pins that changed are written)
+ * @param  Vcd: Pointer to VCD writer
+ * @param  Time: Time of sample in ns (must not decrease)
+ * @param  Data: Input byte of each device
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_Sample(PCA9534_Vcd_t *Vcd, uint64_t Time, const uint8_t *Data)
+{
+  uint8_t TimeWritten = 0;
+  uint8_t Mask = 0;
+  uint16_t i = 0;
+
+  if (!Vcd || !Vcd->File || !Data)
+    return PCA9534_INVALID_PARAM;
+
+  if (!Vcd->Started)
+  {
+    Vcd->Started = 1;
+    Vcd->TimeBase = Time;
+    fprintf(Vcd->File, "#0\n$dumpvars\n");
+    for (i = 0; i < Vcd->DeviceCount; i++)
+    {
+      if (Vcd_Pins(Vcd, i, Data[i], 0xFF) != 0)
+        return PCA9534_FAIL;
+      Vcd->Last[i] = Data[i];
+    }
+    if (fprintf(Vcd->File, "$end\n") < 0)
+      return PCA9534_FAIL;
+    return PCA9534_OK;
+  }
+
+  Time = (Time > Vcd->TimeBase) ? (Time - Vcd->TimeBase) : 0;
+  if (Time < Vcd->TimeLast)
+    Time = Vcd->TimeLast;
+
+  for (i = 0; i < Vcd->DeviceCount; i++)
+  {
+    Mask = Data[i] ^ Vcd->Last[i];
+    if (!Mask)
+      continue;
+
+    if (!TimeWritten && Time != Vcd->TimeLast)
+    {
+      if (fprintf(Vcd->File, "#%" PRIu64 "\n", Time) < 0)
+        return PCA9534_FAIL;
+      Vcd->TimeLast = Time;
+    }
+    TimeWritten = 1;
+
+    if (Vcd_Pins(Vcd, i, Data[i], Mask) != 0)
+      return PCA9534_FAIL;
+    Vcd->Last[i] = Data[i];
+  }
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Finish the VCD output
+ * @param  Vcd: Pointer to VCD writer
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_End(PCA9534_Vcd_t *Vcd)
+{
+  if (!Vcd || !Vcd->File)
+    return PCA9534_INVALID_PARAM;
+
+  if (fflush(Vcd->File) != 0)
+    return PCA9534_FAIL;
+
+  return PCA9534_OK;
+}
+
+
+/**
+ * @brief  Export a whole capture file to VCD in one streaming pass
+ * @param  Capture: Pointer to capture session
+ * @param  File: Output stream
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_Export(const PCA9534_Capture_t *Capture, FILE *File)
+{
+  PCA9534_Vcd_t Vcd;
+  const uint8_t *Data = NULL;
+  uint64_t Count = 0;
+  uint64_t Time = 0;
+  uint64_t i = 0;
+
+  if (!Capture || !Capture->Header || !File)
+    return PCA9534_INVALID_PARAM;
+
+  if (PCA9534_Vcd_Begin(&Vcd, File, Capture->Header->Devices,
+                        Capture->Header->DeviceCount) != PCA9534_OK)
+    return PCA9534_FAIL;
+
+  Count = PCA9534_Capture_Count(Capture);
+  for (i = 0; i < Count; i++)
+  {
+    Data = PCA9534_Capture_Get(Capture, i, &Time);
+    if (PCA9534_Vcd_Sample(&Vcd, Time, Data) != PCA9534_OK)
+      return PCA9534_FAIL;
+  }
+
+  return PCA9534_Vcd_End(&Vcd);
+}
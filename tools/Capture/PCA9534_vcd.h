@@ -0,0 +1,140 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_vcd.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Value Change Dump export of captured pin activity
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef _PCA9534_VCD_H_
+#define _PCA9534_VCD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "PCA9534_capture.h"
+#include <stdint.h>
+#include <stdio.h>
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  VCD writer data type
+ * @note   Memory use is fixed and does not depend on the capture length.
+ */
+typedef struct PCA9534_Vcd_s
+{
+  FILE *File;
+  uint16_t DeviceCount;
+
+  // Time of first sample (ns)
+  uint64_t TimeBase;
+
+  // Last written time (ns, relative to TimeBase)
+  uint64_t TimeLast;
+
+  // 0 until the initial values are dumped
+  uint8_t Started;
+
+  // Last written value of each device
+  uint8_t Last[PCA9534_CAPTURE_DEVICES_MAX];
+} PCA9534_Vcd_t;
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Write the VCD header
+ * @note   Device n is dumped as module "dev<n>_0x<address>" with one wire per
+ *         pin named "P0" to "P7". Time unit is 1 ns.
+ * @param  Vcd: Pointer to VCD writer
+ * @param  File: Output stream
+ * @param  Devices: I2C address of each device
+ * @param  DeviceCount: Number of devices
+ *         (1 <= DeviceCount <= PCA9534_CAPTURE_DEVICES_MAX)
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_Begin(PCA9534_Vcd_t *Vcd, FILE *File, const uint8_t *Devices,
+                  uint16_t DeviceCount);
+
+
+/**
+ * @brief  Write one sample (only the pins that changed are written)
+ * @param  Vcd: Pointer to VCD writer
+ * @param  Time: Time of sample in ns (must not decrease)
+ * @param  Data: Input byte of each device
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_Sample(PCA9534_Vcd_t *Vcd, uint64_t Time, const uint8_t *Data);
+
+
+/**
+ * @brief  Finish the VCD output
+ * @param  Vcd: Pointer to VCD writer
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_End(PCA9534_Vcd_t *Vcd);
+
+
+/**
+ * @brief  Export a whole capture file to VCD in one streaming pass
+ * @param  Capture: Pointer to capture session
+ * @param  File: Output stream
+ * @retval PCA9534_Result_t
+ *         - PCA9534_OK: Operation was successful.
+ *         - PCA9534_FAIL: Failed to write the output.
+ *         - PCA9534_INVALID_PARAM: One of parameters is invalid.
+ */
+PCA9534_Result_t
+PCA9534_Vcd_Export(const PCA9534_Capture_t *Capture, FILE *File);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _PCA9534_VCD_H_
@@ -0,0 +1,511 @@
+/**
+ **********************************************************************************
+ * @file   PCA9534_table_bench.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Device table sweep, diff and scrub benchmark
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/**
+ * Usage: PCA9534_table_bench [devices [rounds]]
+ *
+ * Builds a device table of PCA9534_BENCH_DEVICES devices (at most
+ * PCA9534_BENCH_BUSES * PCA9534_BENCH_PER_BUS) on simulated buses and runs
+ * rounds of sweep and diff, with a scrub every PCA9534_BENCH_SCRUB_EVERY
+ * rounds. Each round changes the inputs of some devices and each scrub
+ * resets some devices; the diff and scrub results are checked against them.
+ * The same rounds are then run on the layout the table replaces: an array
+ * of handlers (with the input values next to each one) swept with
+ * PCA9534_Read and diffed one device at a time. Prints the bytes of state
+ * per device and the devices per second of each operation for both.
+ *
+ * Build:
+ *   cc -O2 -march=native -Isrc/include tools/Table/PCA9534_table_bench.c \
+ *      src/PCA9534_Table.c src/PCA9534.c
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#include "PCA9534_Table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* Private Constants ------------------------------------------------------------*/
+// Default number of devices and rounds
+#define PCA9534_BENCH_DEVICES     10000
+#define PCA9534_BENCH_ROUNDS      64
+
+// Simulated buses and devices per bus (addresses 0x08-0x77)
+#define PCA9534_BENCH_BUSES       90
+#define PCA9534_BENCH_PER_BUS     112
+#define PCA9534_BENCH_ADDRESS     0x08
+
+// Input changes per round and resets per scrub, in devices per 1024
+#define PCA9534_BENCH_CHANGES     10
+#define PCA9534_BENCH_RESETS      2
+
+// Rounds between scrubs
+#define PCA9534_BENCH_SCRUB_EVERY 8
+
+
+
+/* Private Data Types -----------------------------------------------------------*/
+// Device of the baseline layout
+typedef struct Bench_Handler_s
+{
+  PCA9534_Handler_t Handler;
+  uint8_t Input;
+  uint8_t Previous;
+} Bench_Handler_t;
+
+// Time and processed devices of one operation
+typedef struct Bench_Op_s
+{
+  uint64_t Time;
+  uint64_t Devices;
+} Bench_Op_t;
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+// Simulated registers and register pointer of each device of each bus
+static uint8_t Bench_Regs[PCA9534_BENCH_BUSES][128][4];
+static uint8_t Bench_Pointer[PCA9534_BENCH_BUSES][128];
+static uint32_t Bench_Seed = 1;
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint64_t
+Bench_Now(void)
+{
+  struct timespec Ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &Ts);
+  return (uint64_t)Ts.tv_sec * 1000000000ull + (uint64_t)Ts.tv_nsec;
+}
+
+
+static uint32_t
+Bench_Random(void)
+{
+  Bench_Seed = Bench_Seed * 1103515245u + 12345u;
+  return Bench_Seed >> 8;
+}
+
+
+static int8_t
+Bench_Send(uint8_t Bus, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  uint8_t i = 0;
+
+  if (Address < PCA9534_BENCH_ADDRESS ||
+      Address >= PCA9534_BENCH_ADDRESS + PCA9534_BENCH_PER_BUS || !DataLen)
+    return -1;
+
+  Bench_Pointer[Bus][Address] = Data[0] & 0x03;
+  for (i = 1; i < DataLen; i++)
+    Bench_Regs[Bus][Address][Bench_Pointer[Bus][Address]] = Data[i];
+
+  return 0;
+}
+
+
+static int8_t
+Bench_Receive(uint8_t Bus, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  uint8_t i = 0;
+
+  if (Address < PCA9534_BENCH_ADDRESS ||
+      Address >= PCA9534_BENCH_ADDRESS + PCA9534_BENCH_PER_BUS)
+    return -1;
+
+  for (i = 0; i < DataLen; i++)
+    Data[i] = Bench_Regs[Bus][Address][Bench_Pointer[Bus][Address]];
+
+  return 0;
+}
+
+
+// The platform functions have no context, so each bus gets its own pair
+#define BENCH_BUS(N) \
+  static int8_t Bench_Send##N(uint8_t Address, uint8_t *Data, uint8_t Len) \
+  { return Bench_Send(N, Address, Data, Len); } \
+  static int8_t Bench_Receive##N(uint8_t Address, uint8_t *Data, uint8_t Len) \
+  { return Bench_Receive(N, Address, Data, Len); }
+#define BENCH_BUS10(N) \
+  BENCH_BUS(N##0) BENCH_BUS(N##1) BENCH_BUS(N##2) BENCH_BUS(N##3) \
+  BENCH_BUS(N##4) BENCH_BUS(N##5) BENCH_BUS(N##6) BENCH_BUS(N##7) \
+  BENCH_BUS(N##8) BENCH_BUS(N##9)
+#define BENCH_LINK(N) \
+  { Platform[N].Send = Bench_Send##N; Platform[N].Receive = Bench_Receive##N; }
+#define BENCH_LINK10(N) \
+  BENCH_LINK(N##0) BENCH_LINK(N##1) BENCH_LINK(N##2) BENCH_LINK(N##3) \
+  BENCH_LINK(N##4) BENCH_LINK(N##5) BENCH_LINK(N##6) BENCH_LINK(N##7) \
+  BENCH_LINK(N##8) BENCH_LINK(N##9)
+
+BENCH_BUS(0) BENCH_BUS(1) BENCH_BUS(2) BENCH_BUS(3) BENCH_BUS(4)
+BENCH_BUS(5) BENCH_BUS(6) BENCH_BUS(7) BENCH_BUS(8) BENCH_BUS(9)
+BENCH_BUS10(1) BENCH_BUS10(2) BENCH_BUS10(3) BENCH_BUS10(4)
+BENCH_BUS10(5) BENCH_BUS10(6) BENCH_BUS10(7) BENCH_BUS10(8)
+
+
+static void
+Bench_Link(PCA9534_Platform_t *Platform)
+{
+  memset(Platform, 0, PCA9534_BENCH_BUSES * sizeof(PCA9534_Platform_t));
+
+  BENCH_LINK(0) BENCH_LINK(1) BENCH_LINK(2) BENCH_LINK(3) BENCH_LINK(4)
+  BENCH_LINK(5) BENCH_LINK(6) BENCH_LINK(7) BENCH_LINK(8) BENCH_LINK(9)
+  BENCH_LINK10(1) BENCH_LINK10(2) BENCH_LINK10(3) BENCH_LINK10(4)
+  BENCH_LINK10(5) BENCH_LINK10(6) BENCH_LINK10(7) BENCH_LINK10(8)
+}
+
+
+static uint8_t *
+Bench_Device(uint32_t Id)
+{
+  return Bench_Regs[Id / PCA9534_BENCH_PER_BUS]
+                   [PCA9534_BENCH_ADDRESS + Id % PCA9534_BENCH_PER_BUS];
+}
+
+
+// Toggle input pins of some devices, Expected gets the changed pins
+static void
+Bench_Change(uint8_t *Expected, uint32_t Devices)
+{
+  uint32_t Changes = Devices * PCA9534_BENCH_CHANGES / 1024 + 1;
+  uint32_t Id = 0;
+  uint8_t Pin = 0;
+
+  memset(Expected, 0, Devices);
+  while (Changes--)
+  {
+    Id = Bench_Random() % Devices;
+    Pin = (uint8_t)(1u << (Bench_Random() % 8));
+    Expected[Id] ^= Pin;
+    Bench_Device(Id)[0] ^= Pin;
+  }
+}
+
+
+// Check the changes found against Expected (cleared on return)
+static int
+Bench_Check(uint8_t *Expected, uint32_t Devices, const uint16_t *Ids,
+            const uint8_t *Masks, uint16_t Changed)
+{
+  int Same = 1;
+  uint32_t i = 0;
+
+  for (i = 0; i < Changed; i++)
+  {
+    Same &= (Masks[i] == Expected[Ids[i]]);
+    Expected[Ids[i]] = 0;
+  }
+
+  for (i = 0; i < Devices; i++)
+    Same &= !Expected[i];
+
+  return Same;
+}
+
+
+static void
+Bench_Time(Bench_Op_t *Op, uint64_t Start, uint32_t Devices)
+{
+  Op->Time += Bench_Now() - Start;
+  Op->Devices += Devices;
+}
+
+
+static double
+Bench_Rate(const Bench_Op_t *Op)
+{
+  return Op->Devices * 1e9 / (Op->Time ? Op->Time : 1);
+}
+
+
+static void
+Bench_Print(const char *Name, const Bench_Op_t *Table, const Bench_Op_t *Base)
+{
+  if (!Base)
+  {
+    printf("%-6s  %14.0f  %14s  %7s\n", Name, Bench_Rate(Table), "-", "-");
+    return;
+  }
+
+  printf("%-6s  %14.0f  %14.0f  %7.2f\n", Name, Bench_Rate(Table),
+         Bench_Rate(Base), Bench_Rate(Table) / Bench_Rate(Base));
+}
+
+
+static int
+Bench_RunTable(PCA9534_Platform_t *Platform, uint32_t Devices, uint32_t Rounds,
+               Bench_Op_t *Sweep, Bench_Op_t *Diff, Bench_Op_t *Scrub)
+{
+  PCA9534_Table_t Table;
+  void *Storage = malloc(PCA9534_TABLE_STORAGE(Devices));
+  uint16_t *Ids = malloc(Devices * sizeof(uint16_t));
+  uint8_t *Masks = malloc(Devices);
+  uint8_t *Expected = calloc(Devices, 1);
+  uint64_t Start = 0;
+  uint32_t Round = 0;
+  uint32_t Resets = 0;
+  uint32_t i = 0;
+  uint16_t Id = 0;
+  uint16_t Changed = 0;
+  uint16_t Restored = 0;
+  uint8_t *Regs = 0;
+  int Failed = 0;
+
+  if (!Storage || !Ids || !Masks || !Expected ||
+      PCA9534_Table_Init(&Table, Platform, PCA9534_BENCH_BUSES, Storage,
+                         (uint16_t)Devices) != PCA9534_OK)
+  {
+    fprintf(stderr, "Can not initialize table\n");
+    Failed = 1;
+    Rounds = 0;
+    Devices = 0;
+  }
+
+  // Build: lower nibble as outputs
+  for (i = 0; i < Devices; i++)
+  {
+    if (PCA9534_Table_Add(&Table, (uint8_t)(i / PCA9534_BENCH_PER_BUS),
+                          (uint8_t)(PCA9534_BENCH_ADDRESS +
+                                    i % PCA9534_BENCH_PER_BUS),
+                          &Id) != PCA9534_OK ||
+        PCA9534_Table_SetDir(&Table, Id, 0x0F) != PCA9534_OK ||
+        PCA9534_Table_Write(&Table, Id, (uint8_t)i) != PCA9534_OK)
+    {
+      fprintf(stderr, "Can not add device %u\n", i);
+      Failed = 1;
+      Rounds = 0;
+      break;
+    }
+  }
+
+  if (Rounds &&
+      PCA9534_Table_Sweep(&Table, 0, (uint16_t)Devices, 0) != PCA9534_OK)
+    Failed = 1;
+
+  for (Round = 1; Round <= Rounds; Round++)
+  {
+    Bench_Change(Expected, Devices);
+
+    Start = Bench_Now();
+    if (PCA9534_Table_Sweep(&Table, 0, (uint16_t)Devices,
+                            Round) != PCA9534_OK)
+      Failed = 1;
+    Bench_Time(Sweep, Start, Devices);
+
+    Start = Bench_Now();
+    PCA9534_Table_Diff(&Table, 0, (uint16_t)Devices, Ids, Masks, &Changed);
+    Bench_Time(Diff, Start, Devices);
+
+    Failed |= !Bench_Check(Expected, Devices, Ids, Masks, Changed);
+
+    if (Round % PCA9534_BENCH_SCRUB_EVERY)
+      continue;
+
+    // Reset some devices to the power-on values (distinct devices)
+    Resets = 0;
+    for (i = 0; i < Devices * PCA9534_BENCH_RESETS / 1024 + 1; i++)
+    {
+      Regs = Bench_Device(Bench_Random() % Devices);
+      if (Regs[3] == 0xFF)
+        continue;
+      Regs[1] = 0xFF;
+      Regs[3] = 0xFF;
+      Resets++;
+    }
+
+    Start = Bench_Now();
+    if (PCA9534_Table_Scrub(&Table, 0, (uint16_t)Devices,
+                            &Restored) != PCA9534_OK || Restored != Resets)
+      Failed = 1;
+    Bench_Time(Scrub, Start, Devices);
+
+    for (i = 0; i < Devices; i++)
+    {
+      Regs = Bench_Device(i);
+      if (Regs[1] != Table.Output[i] || Regs[3] != Table.Config[i])
+        Failed = 1;
+    }
+  }
+
+  free(Storage);
+  free(Ids);
+  free(Masks);
+  free(Expected);
+
+  return Failed;
+}
+
+
+static int
+Bench_RunHandlers(PCA9534_Platform_t *Platform, uint32_t Devices,
+                  uint32_t Rounds, Bench_Op_t *Sweep, Bench_Op_t *Diff)
+{
+  Bench_Handler_t *Device = calloc(Devices, sizeof(Bench_Handler_t));
+  uint16_t *Ids = malloc(Devices * sizeof(uint16_t));
+  uint8_t *Masks = malloc(Devices);
+  uint8_t *Expected = calloc(Devices, 1);
+  uint64_t Start = 0;
+  uint32_t Round = 0;
+  uint32_t i = 0;
+  uint16_t Changed = 0;
+  int Failed = 0;
+
+  if (!Device || !Ids || !Masks || !Expected)
+  {
+    fprintf(stderr, "Out of memory\n");
+    Failed = 1;
+    Rounds = 0;
+    Devices = 0;
+  }
+
+  // Take over the devices built by the table run (no register is written)
+  for (i = 0; i < Devices; i++)
+  {
+    Device[i].Handler.Platform = Platform[i / PCA9534_BENCH_PER_BUS];
+    if (PCA9534_InitFromDevice(&Device[i].Handler, PCA9534_DEVICE_PCA9534,
+                               0) != PCA9534_OK)
+      Failed = 1;
+
+    // The simulated buses use the whole address range
+    Device[i].Handler.AddressI2C =
+      (uint8_t)(PCA9534_BENCH_ADDRESS + i % PCA9534_BENCH_PER_BUS);
+    Device[i].Input = Bench_Device(i)[0];
+  }
+
+  for (Round = 1; Round <= Rounds; Round++)
+  {
+    Bench_Change(Expected, Devices);
+
+    Start = Bench_Now();
+    for (i = 0; i < Devices; i++)
+    {
+      Device[i].Previous = Device[i].Input;
+      if (PCA9534_Read(&Device[i].Handler, &Device[i].Input) != PCA9534_OK)
+        Failed = 1;
+    }
+    Bench_Time(Sweep, Start, Devices);
+
+    Start = Bench_Now();
+    Changed = 0;
+    for (i = 0; i < Devices; i++)
+    {
+      if (Device[i].Input == Device[i].Previous)
+        continue;
+      Ids[Changed] = (uint16_t)i;
+      Masks[Changed] = Device[i].Input ^ Device[i].Previous;
+      Changed++;
+    }
+    Bench_Time(Diff, Start, Devices);
+
+    Failed |= !Bench_Check(Expected, Devices, Ids, Masks, Changed);
+  }
+
+  free(Device);
+  free(Ids);
+  free(Masks);
+  free(Expected);
+
+  return Failed;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+int
+main(int argc, char **argv)
+{
+  static PCA9534_Platform_t Platform[PCA9534_BENCH_BUSES];
+  Bench_Op_t TableSweep = {0};
+  Bench_Op_t TableDiff = {0};
+  Bench_Op_t TableScrub = {0};
+  Bench_Op_t BaseSweep = {0};
+  Bench_Op_t BaseDiff = {0};
+  uint32_t Devices = PCA9534_BENCH_DEVICES;
+  uint32_t Rounds = PCA9534_BENCH_ROUNDS;
+  uint32_t i = 0;
+  uint8_t *Regs = 0;
+  int Failed = 0;
+
+  if (argc > 1)
+    Devices = (uint32_t)atoi(argv[1]);
+  if (argc > 2)
+    Rounds = (uint32_t)atoi(argv[2]);
+  if (!Devices || Devices > PCA9534_BENCH_BUSES * PCA9534_BENCH_PER_BUS)
+  {
+    fprintf(stderr, "devices must be 1..%u\n",
+            PCA9534_BENCH_BUSES * PCA9534_BENCH_PER_BUS);
+    return 1;
+  }
+
+  Bench_Link(Platform);
+
+  // Power-on registers
+  for (i = 0; i < Devices; i++)
+  {
+    Regs = Bench_Device(i);
+    Regs[0] = 0x00;
+    Regs[1] = 0xFF;
+    Regs[2] = 0x00;
+    Regs[3] = 0xFF;
+  }
+
+  Failed |= Bench_RunTable(Platform, Devices, Rounds, &TableSweep, &TableDiff,
+                           &TableScrub);
+  Failed |= Bench_RunHandlers(Platform, Devices, Rounds, &BaseSweep,
+                              &BaseDiff);
+
+  printf("devices: %u, buses: %u, rounds: %u\n", Devices,
+         (Devices + PCA9534_BENCH_PER_BUS - 1) / PCA9534_BENCH_PER_BUS, Rounds);
+  printf("bytes per device: table %.2f, handlers %u\n",
+         (double)PCA9534_TABLE_STORAGE(Devices) / Devices,
+         (unsigned)sizeof(Bench_Handler_t));
+  printf("op       table devices/s  handler devices/s  speedup\n");
+  Bench_Print("sweep", &TableSweep, &BaseSweep);
+  Bench_Print("diff", &TableDiff, &BaseDiff);
+  Bench_Print("scrub", &TableScrub, NULL);
+  printf("result: %s\n", Failed ? "MISMATCH" : "ok");
+
+  return Failed ? 2 : 0;
+}